@@ -203,13 +203,13 @@ int handle_character_dn_modifiers(Atom current_keymap, size_t *keybind_recurse_c
   if (out == 0) return 0;
   out = handle_modifier(GUI_MODKEY_RSHIFT, 1, &current_keymap, keybind_recurse_count);
   if (out == 0) return 0;
-  env_set(*genv(), make_sym("CURRENT-KEYMAP"), current_keymap);
+  env_set(*genv(), SYM(CURRENT_KEYMAP), current_keymap);
   return 1;
 }
 
 void handle_keydown(char *keystring) {
 #ifdef LITE_DBG
-  int debug_keybinding = env_non_nil(*genv(), make_sym("DEBUG/KEYBINDING"));
+  int debug_keybinding = env_non_nil(*genv(), SYM(DEBUG_KEYBINDING));
   if (debug_keybinding) printf("Keydown: %s\n", keystring ? keystring : "NULL");
 #endif /* LITE_DBG */
 
@@ -225,14 +225,14 @@ void handle_keydown(char *keystring) {
   // keymap bound to "a". Pressing "b" once more will find the
   // valid keybinding (string "ab") and insert its contents.
   Atom current_keymap = nil;
-  env_get(*genv(), make_sym("CURRENT-KEYMAP"), &current_keymap);
+  env_get(*genv(), SYM(CURRENT_KEYMAP), &current_keymap);
 
   // Confidence Check: If the user has borked their current keymap,
   // somehow (accidental let binding, possibly), we reset a `nil`
   // keymap to the top-level root keymap (stored at "KEYMAP" in global
   // environment).
   if (nilp(current_keymap)) {
-    env_get(*genv(), make_sym("KEYMAP"), &current_keymap);
+    env_get(*genv(), SYM(KEYMAP), &current_keymap);
     if (nilp(current_keymap)) {
       // At this point, it is most likely that LITE has been started
       // without any keymap configuration whatsoever (no standard
@@ -255,7 +255,7 @@ void handle_keydown(char *keystring) {
 #endif /* LITE_DBG */
 
   Atom current_buffer = nil;
-  env_get(*genv(), make_sym("CURRENT-BUFFER"), &current_buffer);
+  env_get(*genv(), SYM(CURRENT_BUFFER), &current_buffer);
   // TODO: If CURRENT-BUFFER is somehow borked, maybe we should wait
   // until a keybind actually requires it to fail. Either way, the way
   // we silently return here with no error or message to the user about
@@ -318,7 +318,7 @@ void handle_keydown(char *keystring) {
   //                be evaluated as LITE LISP, with the result of the
   //                evaluation being drawn to the footline.
   while (keystring && keybind_recurse_count < keybind_recurse_limit) {
-    env_get(*genv(), make_sym("CURRENT-KEYMAP"), &current_keymap);
+    env_get(*genv(), SYM(CURRENT_KEYMAP), &current_keymap);
 
 #ifdef LITE_DBG
     if (debug_keybinding) {
@@ -341,12 +341,12 @@ void handle_keydown(char *keystring) {
     if (alistp(keybind)) {
       // Nested keymap, rebind current keymap.
       if (debug_keybinding) printf("Nested keymap found, updating CURRENT-KEYMAP\n");
-      env_set(*genv(), make_sym("CURRENT-KEYMAP"), keybind);
+      env_set(*genv(), SYM(CURRENT_KEYMAP), keybind);
       break;
     }
     if (nilp(keybind)) {
       Atom root_keymap = nil;
-      env_get(*genv(), make_sym("KEYMAP"), &root_keymap);
+      env_get(*genv(), SYM(KEYMAP), &root_keymap);
       // If keybind is nil, it means that the keystring is not bound in current keymap.
       if (pairp(current_keymap) && pairp(root_keymap)
           && current_keymap.value.pair == root_keymap.value.pair)
@@ -367,7 +367,7 @@ void handle_keydown(char *keystring) {
         }
       // Key not bound in current keymap, set current to root_keymap and try again.
       // FIXME: I don't think this makes any sense whatsoever.
-      env_set(*genv(), make_sym("CURRENT-KEYMAP"), root_keymap);
+      env_set(*genv(), SYM(CURRENT_KEYMAP), root_keymap);
       keybind_recurse_count += 1;
       if (debug_keybinding) {
         printf("keybind_recurse_count: %zu\n", keybind_recurse_count);
@@ -419,14 +419,14 @@ void handle_keydown(char *keystring) {
 #endif /* LITE_DBG */
 
     Atom result = nil;
-    Error err = evaluate_expression(keybind, *genv(), &result);
+    Error err = evaluate_expression_transient(keybind, *genv(), &result);
     if (err.type) {
       printf("KEYBIND ");
       print_error(err);
       update_gui_string(&gctx->footline, error_string(err));
       Atom root_keymap = nil;
-      env_get(*genv(), make_sym("KEYMAP"), &root_keymap);
-      env_set(*genv(), make_sym("CURRENT-KEYMAP"), root_keymap);
+      env_get(*genv(), SYM(KEYMAP), &root_keymap);
+      env_set(*genv(), SYM(CURRENT_KEYMAP), root_keymap);
       return;
     }
 
@@ -452,8 +452,8 @@ void handle_keydown(char *keystring) {
   }
 
   // Reset current keymap
-  env_get(*genv(), make_sym("KEYMAP"), &current_keymap);
-  env_set(*genv(), make_sym("CURRENT-KEYMAP"), current_keymap);
+  env_get(*genv(), SYM(KEYMAP), &current_keymap);
+  env_set(*genv(), SYM(CURRENT_KEYMAP), current_keymap);
   if (debug_keybinding) {
     printf("Keymap reset: ");
     print_atom(current_keymap);
@@ -626,9 +626,10 @@ HOTFUNCTION
 int gui_loop(void) {
   // Call all "refresh" functions. Just a list of LISP forms that
   // we then call each `car` of...
+  static GlobalVariable refresh_hook_variable = GLOBAL_VARIABLE("REFRESH-HOOK");
   Atom refresh_hook = nil;
   Atom result = nil;
-  Error err = env_get(*genv(), make_sym("REFRESH-HOOK"), &refresh_hook);
+  Error err = env_get_global(&refresh_hook_variable, &refresh_hook);
   if (!err.type) {
     for(; !nilp(refresh_hook); refresh_hook = cdr(refresh_hook)) {
       err = evaluate_expression(car(refresh_hook), *genv(), &result);
@@ -639,26 +640,30 @@ int gui_loop(void) {
     }
   }
 
+  static GlobalVariable current_buffer_variable = GLOBAL_VARIABLE("CURRENT-BUFFER");
   Atom current_buffer = nil;
-  err = env_get(*genv(), make_sym("CURRENT-BUFFER"), &current_buffer);
+  err = env_get_global(&current_buffer_variable, &current_buffer);
   if (err.type) {
     print_error(err);
   }
 
+  static GlobalVariable active_window_index_variable = GLOBAL_VARIABLE("ACTIVE-WINDOW-INDEX");
   Atom active_window_index = nil;
-  err = env_get(*genv(), make_sym("ACTIVE-WINDOW-INDEX"), &active_window_index);
+  err = env_get_global(&active_window_index_variable, &active_window_index);
   if (err.type) {
     print_error(err);
   }
+  static GlobalVariable window_list_variable = GLOBAL_VARIABLE("WINDOWS");
   Atom window_list = nil;
-  err = env_get(*genv(), make_sym("WINDOWS"), &window_list);
+  err = env_get_global(&window_list_variable, &window_list);
   if (err.type) {
     print_error(err);
   }
 
 #if defined(TREE_SITTER)
+  static GlobalVariable ts_language_variable = GLOBAL_VARIABLE("TREE-SITTER-LANGUAGE");
   Atom ts_language = nil;
-  err = env_get(*genv(), make_sym("TREE-SITTER-LANGUAGE"), &ts_language);
+  err = env_get_global(&ts_language_variable, &ts_language);
   if (err.type && err.type != ERROR_NOT_BOUND) {
     print_error(err);
   }
@@ -769,7 +774,7 @@ int gui_loop(void) {
     // overrendering.
     // FIXME: We should eventually figure out a way to know if a window's
     // contents need redisplayed that aren't this squirrely and complex.
-    static Atom last_contents = {ATOM_TYPE_NIL, {0}, NULL, NULL};
+    static Atom last_contents = {ATOM_TYPE_NIL, {0}};
     if (nilp(compare_atoms(contents, last_contents))) {
       contents_modified = 1;
     }
@@ -998,6 +1003,7 @@ int gui_loop(void) {
           // Remove from beginning.
           // [a b c], last_prop_it=nil, property_it=a
           cdr(car(cdr(cdr(cdr(cdr(window)))))) = cdr(cdr(car(cdr(cdr(cdr(cdr(window)))))));
+          gcol_write_barrier(car(cdr(cdr(cdr(cdr(window))))), cdr(car(cdr(cdr(cdr(cdr(window)))))));
           // [b c], last_prop_it=nil, property_it=a
           property_it = cdr(property_it);
           // [b c], last_prop_it=nil, property_it=b
@@ -1005,6 +1011,7 @@ int gui_loop(void) {
           // Remove from middle.
           // [a b c], last_prop_it=a, property_it=b
           cdr(last_prop_it) = cdr(property_it);
+          gcol_write_barrier(last_prop_it, cdr(property_it));
           // [a c], last_prop_it=a, property_it=b
           property_it = cdr(property_it);
           // [a c], last_prop_it=a, property_it=c
@@ -1028,6 +1035,9 @@ int gui_loop(void) {
     last_window = new_gui_window;
   }
 
+  // About to wait on input; a good time for garbage collection.
+  evaluation_gcol_idle();
+
   return do_gui(gctx);
 }
 
@@ -1059,12 +1069,12 @@ int enter_lite_gui(void) {
       // Reset current keymap to root keymap.
       // TODO/FIXME: Should probably return error code here.
       Atom keymap = nil;
-      err = env_get(*genv(), make_sym("KEYMAP"), &keymap);
+      err = env_get(*genv(), SYM(KEYMAP), &keymap);
       if (err.type) {
         print_error(err);
         return 0;
       }
-      err = env_set(*genv(), make_sym("CURRENT-KEYMAP"), keymap);
+      err = env_set(*genv(), SYM(CURRENT_KEYMAP), keymap);
       if (err.type) {
         print_error(err);
         return 0;
@@ -105,23 +105,15 @@ Error buffer_create_hst_node(Buffer *buffer, BufferHistoryType type, char *data,
   return ok;
 }
 
-Buffer *buffer_create(char *path) {
+Buffer *buffer_init(Buffer *buffer, char *path) {
+  memset(buffer, 0, sizeof(Buffer));
   if (!path) {
     MAKE_ERROR(args, ERROR_ARGUMENTS, nil
-                 , "buffer_create: PATH must not be NULL!"
+                 , "buffer_init: PATH must not be NULL!"
                  , NULL);
     print_error(args);
     return NULL;
   }
-  Buffer *buffer = calloc(1,sizeof(Buffer));
-  if (!buffer) {
-    MAKE_ERROR(oom, ERROR_MEMORY, nil
-               , "buffer_create: Could not allocate new buffer (out of memory)."
-               , "Find a way to free memory on your system."
-               );
-    print_error(oom);
-    return NULL;
-  }
   buffer->path = path;
 
   Rope *rope = NULL;
@@ -133,9 +125,8 @@ Buffer *buffer_create(char *path) {
     rope = rope_create("");
   }
   if (!rope) {
-    free(buffer);
     MAKE_ERROR(err, ERROR_MEMORY, nil
-               , "buffer_create: Could not create rope for new buffer."
+               , "buffer_init: Could not create rope for new buffer."
                , NULL);
     print_error(err);
     return NULL;
@@ -144,6 +135,23 @@ Buffer *buffer_create(char *path) {
   return buffer;
 }
 
+Buffer *buffer_create(char *path) {
+  Buffer *buffer = malloc(sizeof(Buffer));
+  if (!buffer) {
+    MAKE_ERROR(oom, ERROR_MEMORY, nil
+               , "buffer_create: Could not allocate new buffer (out of memory)."
+               , "Find a way to free memory on your system."
+               );
+    print_error(oom);
+    return NULL;
+  }
+  if (!buffer_init(buffer, path)) {
+    free(buffer);
+    return NULL;
+  }
+  return buffer;
+}
+
 size_t buffer_size(Buffer buffer) {
   if (!buffer.rope) { return 0; }
   return buffer.rope->weight;
@@ -858,8 +866,7 @@ Error buffer_save(Buffer buffer) {
   return ok;
 }
 
-void buffer_free(Buffer* buffer) {
-  if (!buffer) { return; }
+void buffer_release(Buffer *buffer) {
   if (buffer->rope) {
     rope_free(buffer->rope);
   }
@@ -880,5 +887,10 @@ void buffer_free(Buffer* buffer) {
     hist_node = hist_node->next;
     free(to_free);
   }
+}
+
+void buffer_free(Buffer* buffer) {
+  if (!buffer) { return; }
+  buffer_release(buffer);
   free(buffer);
 }
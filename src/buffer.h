@@ -77,6 +77,14 @@ typedef struct Buffer {
  */
 Buffer *buffer_create(char *path);
 
+/** Just like buffer_create(), except that the buffer is made in the
+ *  memory at BUFFER instead of in newly allocated memory.
+ *
+ * @return BUFFER, or NULL if the operation can not be completed. The
+ *         buffer must be released with buffer_release() either way.
+ */
+Buffer *buffer_init(Buffer *buffer, char *path);
+
 /// Return the buffer's size in bytes.
 size_t buffer_size(Buffer buffer);
 
@@ -266,6 +274,11 @@ void buffer_print(Buffer buffer);
 /// Save the given buffer to it's visited filepath.
 Error buffer_save(Buffer buffer);
 
+/// Free everything BUFFER owns, but not BUFFER itself.
+void buffer_release(Buffer *buffer);
+
+/// Free everything BUFFER owns, along with BUFFER, as returned by
+/// buffer_create().
 void buffer_free(Buffer* buffer);
 
 #endif /* LITE_BUFFER_H */
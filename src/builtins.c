@@ -2,6 +2,7 @@
 
 #include <assert.h>
 #include <buffer.h>
+#include <bytecode.h>
 #include <error.h>
 #include <environment.h>
 #include <evaluation.h>
@@ -75,6 +76,95 @@
       }                                             \
   } while (0)
 
+/// Define builtin NAME to take ARITY arguments as ARGV, each of the
+/// corresponding type given (see BuiltInVector).
+#define VECTOR_BUILTIN(name, arity, type_error, type_suggestion, ...)  \
+  static Error builtin_##name##_argv(Atom *argv, Atom *result);       \
+  const BuiltInVector builtin_##name##_vector = {                     \
+    builtin_##name, builtin_##name##_argv, (arity),                   \
+    (type_error), (type_suggestion), { __VA_ARGS__ }                  \
+  };                                                                  \
+  Error builtin_##name(Atom arguments, Atom *result) {                \
+    return builtin_vector_apply(&builtin_##name##_vector,             \
+                                arguments, result);                   \
+  }                                                                   \
+  static Error builtin_##name##_argv(Atom *argv, Atom *result)
+
+static Atom vector_list(size_t argc, Atom *argv) {
+  Atom list = nil;
+  while (argc) {
+    list = cons(argv[--argc], list);
+  }
+  return list;
+}
+
+Error builtin_vector_call(const BuiltInVector *builtin, size_t argc, Atom *argv, Atom *result) {
+  if (argc != builtin->arity) {
+    ARG_ERR(vector_list(argc, argv));
+  }
+  for (size_t i = 0; i < argc; ++i) {
+    if (builtin->types[i] != BUILTIN_ANY_TYPE && argv[i].type != builtin->types[i]) {
+      MAKE_ERROR(err_type, ERROR_TYPE,
+                 vector_list(argc, argv),
+                 builtin->type_error,
+                 builtin->type_suggestion);
+      return err_type;
+    }
+  }
+  return builtin->function(argv, result);
+}
+
+/// Call BUILTIN with the list of ARGUMENTS.
+static Error builtin_vector_apply(const BuiltInVector *builtin, Atom arguments, Atom *result) {
+  Atom argv[BUILTIN_VECTOR_ARITY_MAX];
+  size_t argc = 0;
+  for (Atom it = arguments; !nilp(it); it = cdr(it)) {
+    if (!pairp(it) || argc == BUILTIN_VECTOR_ARITY_MAX) {
+      ARG_ERR(arguments);
+    }
+    argv[argc++] = car(it);
+  }
+  return builtin_vector_call(builtin, argc, argv, result);
+}
+
+/// Vector calling conventions, keyed by list calling convention.
+#define BUILTIN_VECTOR_TABLE_CAPACITY 128
+static const BuiltInVector *builtin_vector_table[BUILTIN_VECTOR_TABLE_CAPACITY];
+
+static size_t builtin_vector_hash(BuiltInFunction function) {
+  uint64_t key = (uint64_t)(uintptr_t)function;
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return (size_t)key & (BUILTIN_VECTOR_TABLE_CAPACITY - 1);
+}
+
+void builtin_vector_register(const BuiltInVector *builtin) {
+  static size_t count = 0;
+  size_t index = builtin_vector_hash(builtin->list);
+  while (builtin_vector_table[index] && builtin_vector_table[index] != builtin) {
+    index = (index + 1) & (BUILTIN_VECTOR_TABLE_CAPACITY - 1);
+  }
+  if (!builtin_vector_table[index]) {
+    ++count;
+    assert(count * 2 <= BUILTIN_VECTOR_TABLE_CAPACITY
+           && "Too many vector builtins; increase BUILTIN_VECTOR_TABLE_CAPACITY");
+  }
+  builtin_vector_table[index] = builtin;
+}
+
+HOTFUNCTION
+const BuiltInVector *builtin_vector(BuiltInFunction function) {
+  size_t index = builtin_vector_hash(function);
+  while (builtin_vector_table[index]) {
+    if (builtin_vector_table[index]->list == function) {
+      return builtin_vector_table[index];
+    }
+    index = (index + 1) & (BUILTIN_VECTOR_TABLE_CAPACITY - 1);
+  }
+  return NULL;
+}
+
 const char *const builtin_quit_lisp_name = "QUIT-LISP";
 const char *const builtin_quit_lisp_docstring =
   "(quit-lisp)\n"
@@ -93,7 +183,8 @@ const char *const builtin_docstring_docstring =
   "(docstring ARG)\n"
   "\n"
   "Return the docstring of ARG as a string.\n"
-  "If ARG is a symbol, first get it's value from the current environment.";
+  "If ARG is a symbol, return the docstring it was defined with, if any,\n"
+  "and otherwise first get it's value from the current environment.";
 Error builtin_docstring(Atom arguments, Atom *result) {
   TWO_ARGS(arguments);
 
@@ -110,6 +201,11 @@ Error builtin_docstring(Atom arguments, Atom *result) {
 
   //Atom symbol_in = symbolp(atom) ? atom : nil;
   if (symbolp(atom)) {
+    const char *defined = symbol_docstring(atom);
+    if (defined) {
+      *result = make_string((char *)defined);
+      return ok;
+    }
     Error err = env_get(environment, atom, &atom);
     if (err.type) {
       return err;
@@ -167,8 +263,8 @@ Error builtin_docstring(Atom arguments, Atom *result) {
     *result = make_string(docstring);
     free(docstring);
   } else {
-    if (atom.docstring) {
-      *result = make_string(atom.docstring);
+    if (builtinp(atom) && atom.value.builtin->docstring) {
+      *result = make_string(atom.value.builtin->docstring);
     } else {
       *result = nil;
     }
@@ -176,9 +272,8 @@ Error builtin_docstring(Atom arguments, Atom *result) {
   return ok;
 }
 
-static Error typep(Atom arguments, enum AtomType type, Atom *result) {
-  ONE_ARG(arguments);
-  *result = car(arguments).type == type ? make_sym("T") : nil;
+static Error typep(Atom argument, enum AtomType type, Atom *result) {
+  *result = argument.type == type ? SYM(T) : nil;
   return ok;
 }
 
@@ -187,13 +282,8 @@ const char *const builtin_nilp_docstring =
   "(nilp ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'NIL', otherwise return nil.";
-Error builtin_nilp(Atom arguments, Atom *result) {
-  // Special argument checking because nil is a valid argument.
-  if (!nilp(cdr(arguments))) {
-    ARG_ERR(arguments);
-  }
-  *result = car(arguments).type == ATOM_TYPE_NIL ? make_sym("T") : nil;
-  return ok;
+VECTOR_BUILTIN(nilp, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_NIL, result);
 }
 
 const char *const builtin_pairp_name = "PAIRP";
@@ -201,8 +291,8 @@ const char *const builtin_pairp_docstring =
   "(pairp ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'PAIR', otherwise return nil.";
-Error builtin_pairp(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_PAIR, result);
+VECTOR_BUILTIN(pairp, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_PAIR, result);
 }
 
 const char *const builtin_symbolp_name = "SYMBOLP";
@@ -210,8 +300,8 @@ const char *const builtin_symbolp_docstring =
   "(symbolp ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'SYMBOL', otherwise return nil.";
-Error builtin_symbolp(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_SYMBOL, result);
+VECTOR_BUILTIN(symbolp, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_SYMBOL, result);
 }
 
 const char *const builtin_integerp_name = "INTEGERP";
@@ -219,8 +309,8 @@ const char *const builtin_integerp_docstring =
   "(integerp ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'INTEGER', otherwise return nil.";
-Error builtin_integerp(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_INTEGER, result);
+VECTOR_BUILTIN(integerp, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_INTEGER, result);
 }
 
 const char *const builtin_builtinp_name = "BUILTINP";
@@ -228,8 +318,8 @@ const char *const builtin_builtinp_docstring =
   "(builtinp ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'BUILTIN', otherwise return nil.";
-Error builtin_builtinp(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_BUILTIN, result);
+VECTOR_BUILTIN(builtinp, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_BUILTIN, result);
 }
 
 const char *const builtin_closurep_name = "CLOSUREP";
@@ -237,8 +327,8 @@ const char *const builtin_closurep_docstring =
   "(closurep ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'CLOSURE', otherwise return nil.";
-Error builtin_closurep(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_CLOSURE, result);
+VECTOR_BUILTIN(closurep, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_CLOSURE, result);
 }
 
 const char *const builtin_macrop_name = "MACROP";
@@ -246,8 +336,8 @@ const char *const builtin_macrop_docstring =
   "(macrop ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'MACRO', otherwise return nil.";
-Error builtin_macrop(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_MACRO, result);
+VECTOR_BUILTIN(macrop, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_MACRO, result);
 }
 
 const char *const builtin_stringp_name = "STRINGP";
@@ -255,8 +345,8 @@ const char *const builtin_stringp_docstring =
   "(stringp ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'STRING', otherwise return nil.";
-Error builtin_stringp(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_STRING, result);
+VECTOR_BUILTIN(stringp, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_STRING, result);
 }
 
 const char *const builtin_bufferp_name = "BUFFERP";
@@ -264,8 +354,8 @@ const char *const builtin_bufferp_docstring =
   "(bufferp ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'BUFFER', otherwise return nil.";
-Error builtin_bufferp(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_BUFFER, result);
+VECTOR_BUILTIN(bufferp, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_BUFFER, result);
 }
 
 const char *const builtin_envp_name = "ENVP";
@@ -273,8 +363,8 @@ const char *const builtin_envp_docstring =
   "(envp ARG)\n"
   "\n"
   "Return 'T' iff ARG has a type of 'ENVIRONMENT', otherwise return nil.";
-Error builtin_envp(Atom arguments, Atom *result) {
-  return typep(arguments, ATOM_TYPE_ENVIRONMENT, result);
+VECTOR_BUILTIN(envp, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  return typep(argv[0], ATOM_TYPE_ENVIRONMENT, result);
 }
 
 
@@ -283,9 +373,8 @@ const char *const builtin_not_docstring =
   "(! ARG)\n"
   "\n"
   "Given ARG is nil, return 'T', otherwise return nil.";
-Error builtin_not(Atom arguments, Atom *result) {
-  ONE_ARG(arguments);
-  *result = nilp(car(arguments)) ? make_sym("T") : nil;
+VECTOR_BUILTIN(not, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  *result = nilp(argv[0]) ? SYM(T) : nil;
   return ok;
 }
 
@@ -298,19 +387,18 @@ const char *const builtin_car_docstring =
   "CAR stands for \"Contents of the Address part of Register N\".\n"
   "This was in reference to the machine instructions used to implement\n"
   "LISP originally, in the 1950s.";
-Error builtin_car(Atom arguments, Atom *result) {
-  ONE_ARG(arguments);
+VECTOR_BUILTIN(car, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
   // (car nil) == nil
-  if (nilp(car(arguments))) {
+  if (nilp(argv[0])) {
     *result = nil;
-  } else if (car(arguments).type != ATOM_TYPE_PAIR) {
+  } else if (argv[0].type != ATOM_TYPE_PAIR) {
     MAKE_ERROR(err_type, ERROR_TYPE,
-               car(arguments),
+               argv[0],
                "CAR requires that the argument be a pair",
                NULL);
     return err_type;
   } else {
-    *result = car(car(arguments));
+    *result = car(argv[0]);
   }
   return ok;
 }
@@ -324,18 +412,17 @@ const char *const builtin_cdr_docstring =
   "CDR stands for \"Contents of the Decrement part of the Register N\".\n"
   "This was in reference to the machine instructions used to implement\n"
   "LISP originally, in the 1950s.";
-Error builtin_cdr(Atom arguments, Atom *result) {
-  ONE_ARG(arguments);
-  if (nilp(car(arguments))) {
+VECTOR_BUILTIN(cdr, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  if (nilp(argv[0])) {
     *result = nil;
-  } else if (car(arguments).type != ATOM_TYPE_PAIR) {
+  } else if (argv[0].type != ATOM_TYPE_PAIR) {
     MAKE_ERROR(err_type, ERROR_TYPE,
-               car(arguments),
+               argv[0],
                "CDR requires that the argument be a pair",
                NULL);
     return err_type;
   } else {
-    *result = cdr(car(arguments));
+    *result = cdr(argv[0]);
   }
   return ok;
 }
@@ -345,9 +432,8 @@ const char *const builtin_cons_docstring =
   "(cons LEFT RIGHT)\n"
   "\n"
   "Return a new pair, with LEFT and RIGHT on each side, respectively.";
-Error builtin_cons(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  *result = cons(car(arguments), car(cdr(arguments)));
+VECTOR_BUILTIN(cons, 2, NULL, NULL, BUILTIN_ANY_TYPE, BUILTIN_ANY_TYPE) {
+  *result = cons(argv[0], argv[1]);
   return ok;
 }
 
@@ -356,16 +442,12 @@ const char *const builtin_setcar_docstring =
   "(setcar PAIR VALUE)\n"
   "\n"
   "Set the left side of PAIR to the given VALUE.";
-Error builtin_setcar(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  if (!pairp(car(arguments))) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               car(arguments),
+VECTOR_BUILTIN(setcar, 2,
                "SETCAR requires that the first argument be a pair",
-               NULL);
-    return err_type;
-  }
-  car(car(arguments)) = car(cdr(arguments));
+               NULL,
+               ATOM_TYPE_PAIR, BUILTIN_ANY_TYPE) {
+  car(argv[0]) = argv[1];
+  gcol_write_barrier(argv[0], argv[1]);
   *result = nil;
   return ok;
 }
@@ -375,16 +457,12 @@ const char *const builtin_setcdr_docstring =
   "(setcdr PAIR VALUE)\n"
   "\n"
   "Set the right side of PAIR to the given VALUE.";
-Error builtin_setcdr(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  if (!pairp(car(arguments))) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               car(arguments),
+VECTOR_BUILTIN(setcdr, 2,
                "SETCDR requires that the argument be a pair",
-               NULL);
-    return err_type;
-  }
-  cdr(car(arguments)) = car(cdr(arguments));
+               NULL,
+               ATOM_TYPE_PAIR, BUILTIN_ANY_TYPE) {
+  cdr(argv[0]) = argv[1];
+  gcol_write_barrier(argv[0], argv[1]);
   *result = nil;
   return ok;
 }
@@ -394,10 +472,9 @@ const char *const builtin_member_docstring =
   "(member ELEMENT LIST)\n"
   "\n"
   "Return non-nil iff ELEMENT is an element of LIST.";
-Error builtin_member(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom key = car(arguments);
-  Atom list = car(cdr(arguments));
+VECTOR_BUILTIN(member, 2, NULL, NULL, BUILTIN_ANY_TYPE, BUILTIN_ANY_TYPE) {
+  Atom key = argv[0];
+  Atom list = argv[1];
   *result = nil;
   for (; !nilp(list); list = cdr(list)) {
     Atom equal = compare_atoms(key, car(list));
@@ -412,9 +489,8 @@ const char *const builtin_length_docstring =
   "\n"
   "Return the length of SEQUENCE, if it is a string, symbol, or list.\n"
   "Otherwise, return nil.\n";
-Error builtin_length(Atom arguments, Atom *result) {
-  ONE_ARG(arguments);
-  Atom arg = car(arguments);
+VECTOR_BUILTIN(length, 1, NULL, NULL, BUILTIN_ANY_TYPE) {
+  Atom arg = argv[0];
   size_t size = 0;
   if (pairp(arg)) {
     for (; !nilp(arg); arg = cdr(arg)) {
@@ -436,17 +512,12 @@ const char *const builtin_add_docstring =
   "(+ A B)\n"
   "\n"
   "Add two integer numbers A and B together, and return the computed result.";
-Error builtin_add(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(add, 2,
                "+ requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   *result = make_int(lhs.value.integer + rhs.value.integer);
   return ok;
 }
@@ -456,17 +527,12 @@ const char *const builtin_subtract_docstring =
   "(- A B)\n"
   "\n"
   "Subtract integer B from integer A and return the computed result.";
-Error builtin_subtract(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(subtract, 2,
                "- requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   *result = make_int(lhs.value.integer - rhs.value.integer);
   return ok;
 }
@@ -476,17 +542,12 @@ const char *const builtin_multiply_docstring =
   "(* A B)\n"
   "\n"
   "Multiply integer numbers A and B together and return the computed result.";
-Error builtin_multiply(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(multiply, 2,
                "* requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   *result = make_int(lhs.value.integer * rhs.value.integer);
   return ok;
 }
@@ -497,20 +558,15 @@ const char *const builtin_divide_docstring =
   "\n"
   "Divide integer B out of integer A and return the computed result.\n"
   "`(/ 6 3)` == \"6 / 3\" == 2";
-Error builtin_divide(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(divide, 2,
                "/ requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   if (rhs.value.integer == 0) {
     MAKE_ERROR(div_by_zero_err, ERROR_GENERIC,
-               arguments,
+               vector_list(2, argv),
                "Never, in any circumstances, may one divide by zero.",
                NULL);
     return div_by_zero_err;
@@ -524,17 +580,12 @@ const char *const builtin_remainder_docstring =
   "(% N M)\n"
   "\n"
   "Return the remainder left when N is divided by M.";
-Error builtin_remainder(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom n = car(arguments);
-  Atom m = car(cdr(arguments));
-  if (!integerp(n) || !integerp(m)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(remainder, 2,
                "% requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom n = argv[0];
+  Atom m = argv[1];
   *result = make_int(n.value.integer % m.value.integer);
   return ok;
 }
@@ -544,17 +595,12 @@ const char *const builtin_bitand_docstring =
   "(bitand LHS RHS)\n"
   "\n"
   "Given two integers, return their bitwise and as if they were two's-complement.";
-Error builtin_bitand(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(bitand, 2,
                "BITAND requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   *result = make_int(lhs.value.integer & rhs.value.integer);
   return ok;
 }
@@ -564,17 +610,12 @@ const char *const builtin_bitor_docstring =
   "(bitor LHS RHS)\n"
   "\n"
   "Given two integers, return their bitwise or as if they were two's-complement.";
-Error builtin_bitor(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(bitor, 2,
                "BITOR requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   *result = make_int(lhs.value.integer | rhs.value.integer);
   return ok;
 }
@@ -584,17 +625,12 @@ const char *const builtin_bitxor_docstring =
   "(bitxor LHS RHS)\n"
   "\n"
   "Given two integers, return their bitwise exlusive or as if they were two's-complement.";
-Error builtin_bitxor(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(bitxor, 2,
                "BITXOR requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   *result = make_int(lhs.value.integer ^ rhs.value.integer);
   return ok;
 }
@@ -604,16 +640,11 @@ const char *const builtin_bitnot_docstring =
   "(bitnot OPERAND)\n"
   "\n"
   "Given an integer, return the bitwise NOT as if it was two's complement.";
-Error builtin_bitnot(Atom arguments, Atom *result) {
-  ONE_ARG(arguments);
-  Atom op = car(arguments);
-  if (!integerp(op)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BITNOT requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+VECTOR_BUILTIN(bitnot, 1,
+               "BITNOT requires that the given argument be an integer",
+               NULL,
+               ATOM_TYPE_INTEGER) {
+  Atom op = argv[0];
   *result = make_int(~op.value.integer);
   return ok;
 }
@@ -623,17 +654,12 @@ const char *const builtin_bitshl_docstring =
   "(bitshl LHS RHS)\n"
   "\n"
   "Given two integers, return LHS shifted to the left by RHS bits.";
-Error builtin_bitshl(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(bitshl, 2,
                "BITSHL requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   *result = make_int(lhs.value.integer << rhs.value.integer);
   return ok;
 }
@@ -643,17 +669,12 @@ const char *const builtin_bitshr_docstring =
   "(bitshr LHS RHS)\n"
   "\n"
   "Given two integers, return LHS shifted to the right by RHS bits.";
-Error builtin_bitshr(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(bitshr, 2,
                "BITSHR requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
   *result = make_int(lhs.value.integer >> rhs.value.integer);
   return ok;
 }
@@ -730,6 +751,37 @@ Error builtin_env_set_direct(Atom arguments, Atom *result) {
   return err;
 }
 
+const char *const builtin_env_remove_direct_name = "ENV-REMOVE-DIRECT";
+const char *const builtin_env_remove_direct_docstring =
+  "(env-remove-direct ENV SYMBOL)\n"
+  "\n"
+  "Remove the binding of SYMBOL from ENV, leaving any binding of it in\n"
+  "a parent of ENV alone. Return T iff SYMBOL was bound in ENV.\n";
+Error builtin_env_remove_direct(Atom arguments, Atom *result) {
+  TWO_ARGS(arguments);
+
+  Atom env = car(arguments);
+  Atom sym = car(cdr(arguments));
+
+  if (!envp(env)) {
+    MAKE_ERROR(err_type, ERROR_TYPE,
+               arguments,
+               "ENV-REMOVE-DIRECT requires the first argument to be an environment",
+               NULL);
+    return err_type;
+  }
+  if (!symbolp(sym)) {
+    MAKE_ERROR(err_type, ERROR_TYPE,
+               arguments,
+               "ENV-REMOVE-DIRECT requires the second argument to be a symbol",
+               NULL);
+    return err_type;
+  }
+
+  *result = env_remove(env, sym) ? SYM(T) : nil;
+  return ok;
+}
+
 const char *const builtin_env_get_name = "ENV-GET";
 const char *const builtin_env_get_docstring =
   "(env-get ENV SYMBOL)\n"
@@ -766,7 +818,7 @@ Error builtin_env_get(Atom arguments, Atom *result) {
   }
   if (err.type == ERROR_NOT_BOUND) {
     err = ok;
-    *result = make_sym("NOT-BOUND");
+    *result = SYM(NOT_BOUND);
   }
   return err;
 }
@@ -800,7 +852,7 @@ Error builtin_env_get_direct(Atom arguments, Atom *result) {
   Error err = env_get(env, sym, result);
   if (err.type == ERROR_NOT_BOUND) {
     err = ok;
-    *result = make_sym("NOT-BOUND");
+    *result = SYM(NOT_BOUND);
   }
   return err;
 }
@@ -871,7 +923,7 @@ Error builtin_buffer_toggle_mark(Atom arguments, Atom *result) {
   buffer_toggle_mark(buffer.value.buffer);
   *result = nil;
   if (buffer_mark_active(*buffer.value.buffer)) {
-    *result = make_sym("T");
+    *result = SYM(T);
   }
   return ok;
 }
@@ -925,7 +977,7 @@ Error builtin_buffer_set_mark(Atom arguments, Atom *result) {
   buffer_set_mark(buffer.value.buffer, (size_t)mark.value.integer);
   *result = nil;
   if (buffer_mark_active(*buffer.value.buffer)) {
-    *result = make_sym("T");
+    *result = SYM(T);
   }
   return ok;
 }
@@ -964,7 +1016,7 @@ Error builtin_buffer_mark_activated(Atom arguments, Atom *result) {
   }
   *result = nil;
   if (buffer_mark_active(*buffer.value.buffer)) {
-    *result = make_sym("T");
+    *result = SYM(T);
   }
   return ok;
 }
@@ -1043,7 +1095,7 @@ Error builtin_open_buffer(Atom arguments, Atom *result) {
 
   // Attempt to load relative to path of current buffer.
   Atom current_buffer = nil;
-  Error err = env_get(*genv(), make_sym("CURRENT-BUFFER"), &current_buffer);
+  Error err = env_get(*genv(), SYM(CURRENT_BUFFER), &current_buffer);
   if (!err.type && bufferp(current_buffer)) {
     working_path = string_trijoin(current_buffer.value.buffer->path, "/../", path.value.symbol);
     if (file_exists(working_path)) {
@@ -1116,29 +1168,47 @@ Error builtin_buffer_table(Atom arguments, Atom *result) {
   return ok;
 }
 
+const char *const builtin_close_buffer_name = "CLOSE-BUFFER";
+const char *const builtin_close_buffer_docstring =
+  "(close-buffer BUFFER)\n"
+  "\n"
+  "Remove BUFFER from the buffer table, returning non-nil iff it was in it.\n"
+  "Opening the same path again makes a new buffer, and BUFFER is freed\n"
+  "once nothing refers to it any longer.";
+VECTOR_BUILTIN(close_buffer, 1,
+               "CLOSE-BUFFER requires a single buffer argument",
+               NULL,
+               ATOM_TYPE_BUFFER) {
+  Atom buffer = argv[0];
+  *result = nil;
+  Atom previous = nil;
+  for (Atom it = *buf_table(); !nilp(it); previous = it, it = cdr(it)) {
+    if (car(it).value.buffer != buffer.value.buffer) {
+      continue;
+    }
+    if (nilp(previous)) {
+      *buf_table() = cdr(it);
+    } else {
+      cdr(previous) = cdr(it);
+      gcol_write_barrier(previous, cdr(it));
+    }
+    *result = SYM(T);
+    break;
+  }
+  return ok;
+}
+
 const char *const builtin_buffer_insert_name = "BUFFER-INSERT";
 const char *const builtin_buffer_insert_docstring =
   "(buffer-insert BUFFER STRING) \n"
   "\n"
   "Insert STRING into BUFFER at point.";
-Error builtin_buffer_insert(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom buffer = car(arguments);
-  Atom string = car(cdr(arguments));
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-INSERT requires that the first argument be a buffer",
-               NULL);
-    return err_type;
-  }
-  if (!stringp(string)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-INSERT requires that the second argument be a string",
-               NULL);
-    return err_type;
-  }
+VECTOR_BUILTIN(buffer_insert, 2,
+               "BUFFER-INSERT requires a buffer and a string",
+               NULL,
+               ATOM_TYPE_BUFFER, ATOM_TYPE_STRING) {
+  Atom buffer = argv[0];
+  Atom string = argv[1];
   Error err = buffer_insert(buffer.value.buffer, (char *)string.value.symbol);
   if (err.type) {
     return err;
@@ -1153,24 +1223,12 @@ const char *const builtin_buffer_remove_docstring =
   "\n"
   "Backspace COUNT bytes from BUFFER at point.\n"
 "Return the amount of bytes actually removed.";
-Error builtin_buffer_remove(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom buffer = car(arguments);
-  Atom count = car(cdr(arguments));
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-REMOVE requires that the first argument be a buffer",
-               NULL);
-    return err_type;
-  }
-  if (!integerp(count)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-REMOVE requires that the second argument be an integer",
-               NULL);
-    return err_type;
-  }
+VECTOR_BUILTIN(buffer_remove, 2,
+               "BUFFER-REMOVE requires a buffer and an integer",
+               NULL,
+               ATOM_TYPE_BUFFER, ATOM_TYPE_INTEGER) {
+  Atom buffer = argv[0];
+  Atom count = argv[1];
   *result = make_int(0);
   size_t removed = (size_t)count.value.integer;
   Error err = buffer_remove_bytes(buffer.value.buffer, &removed);
@@ -1186,24 +1244,12 @@ const char *const builtin_buffer_remove_forward_docstring =
   "(buffer-remove-forward BUFFER COUNT) \n"
   "\n"
   "Remove COUNT bytes from BUFFER following point.";
-Error builtin_buffer_remove_forward(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom buffer = car(arguments);
-  Atom count = car(cdr(arguments));
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-REMOVE-FORWARD requires that the first argument be a buffer",
-               NULL);
-    return err_type;
-  }
-  if (!integerp(count)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-REMOVE-FORWARD requires that the second argument be an integer",
-               NULL);
-    return err_type;
-  }
+VECTOR_BUILTIN(buffer_remove_forward, 2,
+               "BUFFER-REMOVE-FORWARD requires a buffer and an integer",
+               NULL,
+               ATOM_TYPE_BUFFER, ATOM_TYPE_INTEGER) {
+  Atom buffer = argv[0];
+  Atom count = argv[1];
   *result = make_int(0);
   size_t removed = (size_t)count.value.integer;
   Error err = buffer_remove_bytes_forward(buffer.value.buffer, &removed);
@@ -1217,17 +1263,12 @@ Error builtin_buffer_remove_forward(Atom arguments, Atom *result) {
 const char *const builtin_buffer_undo_name = "BUFFER-UNDO";
 const char *const builtin_buffer_undo_docstring =
   "(buffer-undo BUFFER)";
-Error builtin_buffer_undo(Atom arguments, Atom *result) {
-  (void)result;
-  ONE_ARG(arguments);
-  Atom buffer = car(arguments);
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(buffer_undo, 1,
                "BUFFER-UNDO requires a single buffer argument",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_BUFFER) {
+  (void)result;
+  Atom buffer = argv[0];
   Error err = buffer_undo(buffer.value.buffer);
   if (err.type) {
     return err;
@@ -1237,17 +1278,12 @@ Error builtin_buffer_undo(Atom arguments, Atom *result) {
 const char *const builtin_buffer_redo_name = "BUFFER-REDO";
 const char *const builtin_buffer_redo_docstring =
   "(buffer-redo BUFFER)";
-Error builtin_buffer_redo(Atom arguments, Atom *result) {
-  (void)result;
-  ONE_ARG(arguments);
-  Atom buffer = car(arguments);
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(buffer_redo, 1,
                "BUFFER-REDO requires a single buffer argument",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_BUFFER) {
+  (void)result;
+  Atom buffer = argv[0];
   Error err = buffer_redo(buffer.value.buffer);
   if (err.type) {
     return err;
@@ -1261,24 +1297,12 @@ const char *const builtin_buffer_set_point_docstring =
   "\n"
   "Set byte offset of cursor within BUFFER to POINT.\n"
 "Return difference of new point from old point.";
-Error builtin_buffer_set_point(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom buffer = car(arguments);
-  Atom point = car(cdr(arguments));
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-SET-POINT requires that the first argument be a buffer",
-               NULL);
-    return err_type;
-  }
-  if (!integerp(point)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-SET-POINT requires that the second argument be an integer",
-               NULL);
-    return err_type;
-  }
+VECTOR_BUILTIN(buffer_set_point, 2,
+               "BUFFER-SET-POINT requires a buffer and an integer",
+               NULL,
+               ATOM_TYPE_BUFFER, ATOM_TYPE_INTEGER) {
+  Atom buffer = argv[0];
+  Atom point = argv[1];
 
   size_t new_point_byte = 0;
   if (point.value.integer >= 0) {
@@ -1302,16 +1326,11 @@ const char *const builtin_buffer_point_docstring =
   "(buffer-point BUFFER) \n"
   "\n"
   "Get byte offset of cursor (point) within BUFFER.";
-Error builtin_buffer_point (Atom arguments, Atom *result) {
-  ONE_ARG(arguments);
-  Atom buffer = car(arguments);
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(buffer_point, 1,
                "BUFFER-POINT requires a single buffer argument",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_BUFFER) {
+  Atom buffer = argv[0];
   *result = make_int((integer_t)buffer.value.buffer->point_byte);
   return ok;
 }
@@ -1321,24 +1340,12 @@ const char *const builtin_buffer_index_docstring =
   "(buffer-index BUFFER INDEX)\n"
   "\n"
   "Get character from BUFFER at INDEX";
-Error builtin_buffer_index (Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom buffer = car(arguments);
-  Atom index = car(cdr(arguments));
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-INDEX requires that the first argument be a buffer",
-               NULL);
-    return err_type;
-  }
-  if (!integerp(index)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-INDEX requires that the second argument be an integer",
-               NULL);
-    return err_type;
-  }
+VECTOR_BUILTIN(buffer_index, 2,
+               "BUFFER-INDEX requires a buffer and an integer",
+               NULL,
+               ATOM_TYPE_BUFFER, ATOM_TYPE_INTEGER) {
+  Atom buffer = argv[0];
+  Atom index = argv[1];
   char one_byte_string[2];
   one_byte_string[0] = rope_index(buffer.value.buffer->rope
                                   , (size_t)index.value.integer);
@@ -1353,16 +1360,11 @@ const char *const builtin_buffer_string_docstring =
   "\n"
   "Get the contents of BUFFER as a string. "
   "Be careful with large files.";
-Error builtin_buffer_string(Atom arguments, Atom *result) {
-  ONE_ARG(arguments);
-  Atom buffer = car(arguments);
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(buffer_string, 1,
                "BUFFER-STRING requires a single buffer argument",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_BUFFER) {
+  Atom buffer = argv[0];
   char *contents = buffer_string(*buffer.value.buffer);
   if (!contents) {
     MAKE_ERROR(err, ERROR_GENERIC,
@@ -1380,32 +1382,13 @@ const char *const builtin_buffer_lines_docstring =
   "(buffer-lines BUFFER START-LINE LINE-COUNT)\n"
   "\n"
   "Get LINE-COUNT lines starting at START-LINE within BUFFER.";
-Error builtin_buffer_lines (Atom arguments, Atom *result) {
-  THREE_ARGS(arguments);
-  Atom buffer = car(arguments);
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-LINES requires that the first argument be a buffer",
-               NULL);
-    return err_type;
-  }
-  Atom start_line = car(cdr(arguments));
-  if (!integerp(start_line)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-LINES requires that the second argument be an integer",
-               NULL);
-    return err_type;
-  }
-  Atom line_count = car(cdr(cdr(arguments)));
-  if (!integerp(line_count)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-LINES requires that the third argument be an integer",
-               NULL);
-    return err_type;
-  }
+VECTOR_BUILTIN(buffer_lines, 3,
+               "BUFFER-LINES requires a buffer and two integers",
+               NULL,
+               ATOM_TYPE_BUFFER, ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom buffer = argv[0];
+  Atom start_line = argv[1];
+  Atom line_count = argv[2];
   char *lines = buffer_lines
     (*buffer.value.buffer
      , (size_t)start_line.value.integer
@@ -1420,24 +1403,12 @@ const char *const builtin_buffer_line_docstring =
   "(buffer-line BUFFER LINE-NUMBER)\n"
   "\n"
   "Get line LINE-NUMBER from BUFFER contents as string.";
-Error builtin_buffer_line  (Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom buffer = car(arguments);
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-LINE requires that the first argument be a buffer",
-               NULL);
-    return err_type;
-  }
-  Atom line_count = car(cdr(arguments));
-  if (!integerp(line_count)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
-               "BUFFER-LINE requires that the second argument be an integer",
-               NULL);
-    return err_type;
-  }
+VECTOR_BUILTIN(buffer_line, 2,
+               "BUFFER-LINE requires a buffer and an integer",
+               NULL,
+               ATOM_TYPE_BUFFER, ATOM_TYPE_INTEGER) {
+  Atom buffer = argv[0];
+  Atom line_count = argv[1];
   char *line = buffer_line(*buffer.value.buffer, (size_t)line_count.value.integer);
   *result = make_string(line);
   free(line);
@@ -1449,16 +1420,11 @@ const char *const builtin_buffer_current_line_docstring =
   "(buffer-current-line BUFFER)\n"
   "\n"
   "Get line surrounding point in BUFFER as string.";
-Error builtin_buffer_current_line(Atom arguments, Atom *result) {
-  ONE_ARG(arguments);
-  Atom buffer = car(arguments);
-  if (!bufferp(buffer)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(buffer_current_line, 1,
                "BUFFER-CURRENT-LINE requires a single buffer argument",
-               NULL);
-    return err_type;
-  }
+               NULL,
+               ATOM_TYPE_BUFFER) {
+  Atom buffer = argv[0];
   char *line = buffer_current_line(*buffer.value.buffer);
   *result = make_string(line);
   free(line);
@@ -1470,18 +1436,13 @@ const char *const builtin_numeq_docstring =
   "(= ARG1 ARG2)\n"
   "\n"
   "Return 'T' iff the two given arguments have the same integer value.";
-Error builtin_numeq(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(numeq, 2,
                "= requires that both of the given arguments be integers",
-               "Use 'eq' to compare equality of atoms regardless of type.");
-    return err_type;
-  }
-  *result = lhs.value.integer == rhs.value.integer ? make_sym("T") : nil;
+               "Use 'eq' to compare equality of atoms regardless of type.",
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
+  *result = lhs.value.integer == rhs.value.integer ? SYM(T) : nil;
   return ok;
 }
 
@@ -1490,18 +1451,13 @@ const char *const builtin_numnoteq_docstring =
   "(!= ARG1 ARG2) \n"
   "\n"
   "Return 'T' iff the two given arguments *do not* have the same integer value.";
-Error builtin_numnoteq(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(numnoteq, 2,
                "!= requires that both of the given arguments be integers",
-               "Use 'eq' to compare equality of atoms regardless of type.");
-    return err_type;
-  }
-  *result = lhs.value.integer != rhs.value.integer ? make_sym("T") : nil;
+               "Use 'eq' to compare equality of atoms regardless of type.",
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
+  *result = lhs.value.integer != rhs.value.integer ? SYM(T) : nil;
   return ok;
 }
 
@@ -1510,18 +1466,13 @@ const char *const builtin_numlt_docstring =
   "(< INT-A INT-B)\n"
   "\n"
   "Return 'T' iff integer A is less than integer B.";
-Error builtin_numlt(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(numlt, 2,
                "< requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
-  *result = lhs.value.integer < rhs.value.integer ? make_sym("T") : nil;
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
+  *result = lhs.value.integer < rhs.value.integer ? SYM(T) : nil;
   return ok;
 }
 
@@ -1530,18 +1481,13 @@ const char *const builtin_numlt_or_eq_docstring =
   "(<= INT-A INT-B)\n"
   "\n"
   "Return 'T' iff integer A is less than or equal to integer B.";
-Error builtin_numlt_or_eq(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(numlt_or_eq, 2,
                "<= requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
-  *result = lhs.value.integer <= rhs.value.integer ? make_sym("T") : nil;
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
+  *result = lhs.value.integer <= rhs.value.integer ? SYM(T) : nil;
   return ok;
 }
 
@@ -1550,18 +1496,13 @@ const char *const builtin_numgt_docstring =
   "(> INT-A INT-B)\n"
   "\n"
   "Return 'T' iff integer A is greater than integer B.";
-Error builtin_numgt(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(numgt, 2,
                "> requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
-  *result = lhs.value.integer > rhs.value.integer ? make_sym("T") : nil;
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
+  *result = lhs.value.integer > rhs.value.integer ? SYM(T) : nil;
   return ok;
 }
 
@@ -1570,18 +1511,13 @@ const char *const builtin_numgt_or_eq_docstring =
   "(>= INT-A INT-B)\n"
   "\n"
   "Return 'T' iff integer A is greater than or equal to integer B.";
-Error builtin_numgt_or_eq(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  Atom lhs = car(arguments);
-  Atom rhs = car(cdr(arguments));
-  if (!integerp(lhs) || !integerp(rhs)) {
-    MAKE_ERROR(err_type, ERROR_TYPE,
-               arguments,
+VECTOR_BUILTIN(numgt_or_eq, 2,
                ">= requires that both of the given arguments be integers",
-               NULL);
-    return err_type;
-  }
-  *result = lhs.value.integer >= rhs.value.integer ? make_sym("T") : nil;
+               NULL,
+               ATOM_TYPE_INTEGER, ATOM_TYPE_INTEGER) {
+  Atom lhs = argv[0];
+  Atom rhs = argv[1];
+  *result = lhs.value.integer >= rhs.value.integer ? SYM(T) : nil;
   return ok;
 }
 
@@ -1731,9 +1667,8 @@ Error copy_impl(Atom *copy, Atom *result) {
     *result = make_int(copy->value.integer);
     break;
   case ATOM_TYPE_BUILTIN:
-    *result = make_builtin(copy->value.builtin.function,
-                           copy->value.builtin.name,
-                           copy->docstring);
+    // Builtins are never changed, so the copy shares it's BuiltIn.
+    *result = *copy;
     break;
   case ATOM_TYPE_STRING:
     *result = make_string(copy->value.symbol);
@@ -2035,7 +1970,7 @@ Error builtin_evaluate_file(Atom arguments, Atom *result) {
   if (err.type == ERROR_FILE) {
     // Attempt to load relative to path of current buffer.
     Atom current_buffer;
-    err = env_get(*genv(), make_sym("CURRENT-BUFFER"), &current_buffer);
+    err = env_get(*genv(), SYM(CURRENT_BUFFER), &current_buffer);
     // Treat current buffer path as file.
     if (bufferp(current_buffer) && current_buffer.value.buffer) {
       char *path = string_trijoin(current_buffer.value.buffer->path, "/../", filepath.value.symbol);
@@ -2088,7 +2023,7 @@ Error builtin_save(Atom arguments, Atom *result) {
   if (err.type) {
     return err;
   }
-  *result = make_sym("T");
+  *result = SYM(T);
   return ok;
 }
 
@@ -2117,7 +2052,7 @@ Error builtin_apply(Atom arguments, Atom *result) {
   }
 
   if (function.type == ATOM_TYPE_BUILTIN) {
-    return (*function.value.builtin.function)(arguments, result);
+    return (*function.value.builtin->function)(arguments, result);
   } else if (function.type != ATOM_TYPE_CLOSURE) {
     pretty_print_atom(function);
     MAKE_ERROR(err, ERROR_TYPE,
@@ -2126,47 +2061,7 @@ Error builtin_apply(Atom arguments, Atom *result) {
                NULL);
     return err;
   }
-  // Handle closure.
-  // Layout: FUNCTION ARGUMENTS . BODY
-  Atom environment = env_create(car(function), 2 << 2);
-  Atom argument_names = car(cdr(function));
-  Atom body = cdr(cdr(function));
-  // Bind arguments into local environment.
-  while (!nilp(argument_names)) {
-    // Handle variadic arguments.
-    if (argument_names.type == ATOM_TYPE_SYMBOL) {
-      env_set(environment, argument_names, arguments);
-      arguments = nil;
-      break;
-    }
-    if (nilp(arguments)) {
-      MAKE_ERROR(arg_error, ERROR_ARGUMENTS,
-                 arguments,
-                 "APPLY: Not enough arguments passed to applied function!",
-                 NULL);
-      return arg_error;
-    }
-    env_set(environment, car(argument_names), car(arguments));
-    argument_names = cdr(argument_names);
-    arguments = cdr(arguments);
-  }
-  if (!nilp(arguments)) {
-    MAKE_ERROR(arg_error, ERROR_ARGUMENTS,
-               arguments,
-               "APPLY: Too many arguments passed to applied function!",
-               NULL);
-    return arg_error;
-  }
-  // Evaluate body of closure.
-  while (!nilp(body)) {
-    Error err = evaluate_expression(car(body), environment, result);
-    if (err.type) { return err; }
-    if (user_quit) {
-      break;
-    }
-    body = cdr(body);
-  }
-  return ok;
+  return bytecode_apply(function, arguments, result, NULL);
 }
 
 const char *const builtin_eq_name = "EQ";
@@ -2174,9 +2069,8 @@ const char *const builtin_eq_docstring =
   "(eq A B)\n"
   "\n"
   "Return 'T' iff A and B refer to the same Atomic LISP object.";
-Error builtin_eq(Atom arguments, Atom *result) {
-  TWO_ARGS(arguments);
-  *result = compare_atoms(car(arguments), car(cdr(arguments)));
+VECTOR_BUILTIN(eq, 2, NULL, NULL, BUILTIN_ANY_TYPE, BUILTIN_ANY_TYPE) {
+  *result = compare_atoms(argv[0], argv[1]);
   return ok;
 }
 
@@ -2191,6 +2085,28 @@ Error builtin_symbol_table(Atom arguments, Atom *result) {
   return ok;
 }
 
+const char *const builtin_garbage_collector_statistics_name = "GARBAGE-COLLECTOR-STATISTICS";
+const char *const builtin_garbage_collector_statistics_docstring =
+  "(garbage-collector-statistics)\n"
+  "\n"
+  "Return an association list of statistics about garbage collection.\n"
+  "MINOR-COLLECTIONS and MAJOR-COLLECTIONS count finished collections.\n"
+  "TRIGGER is why the most recent collection was started, and TRIGGERS\n"
+  "counts each reason.\n"
+  "PAUSES counts every time evaluation stopped for garbage collection;\n"
+  "PAUSE-LAST, PAUSE-MAX and PAUSE-TOTAL are in microseconds.\n"
+  "PAUSE-HISTOGRAM counts pauses up to each number of microseconds, and\n"
+  "any longer at T.\n"
+  "YOUNG-PAIRS counts pairs allocated before each minor collection, and\n"
+  "PROMOTED-PAIRS how many of those survived it.\n"
+  "LIVE has the number of objects of each type, and the bytes they take\n"
+  "up, as of the most recent major collection.";
+Error builtin_garbage_collector_statistics(Atom arguments, Atom *result) {
+  NO_ARGS(arguments);
+  *result = evaluation_gcol_statistics();
+  return ok;
+}
+
 const char *const builtin_print_name = "PRINT";
 const char *const builtin_print_docstring =
   "(print ARG)\n"
@@ -2252,14 +2168,17 @@ Error builtin_read_prompted(Atom arguments, Atom *result) {
   // Bind return to 'finish-read', but save old binding of return so it can be restored.
   // TODO: Just make a named keymap and add it to keymaps list in the global position.
   Atom keymap = nil;
-  env_get(*genv(), make_sym("KEYMAP"), &keymap);
+  env_get(*genv(), SYM(KEYMAP), &keymap);
   Atom original_return_binding = alist_get(keymap, make_string(LITE_KEYSTRING_RETURN));
-  alist_set(&keymap, make_string(LITE_KEYSTRING_RETURN), cons(make_sym("FINISH-READ"), nil));
-  env_set(*genv(), make_sym("KEYMAP"), keymap);
-  env_set(*genv(), make_sym("CURRENT-KEYMAP"), keymap);
+  // Nothing else refers to it while reading, and reading evaluates.
+  gcol_root_push(&original_return_binding);
+  alist_set(&keymap, make_string(LITE_KEYSTRING_RETURN), cons(SYM(FINISH_READ), nil));
+  env_set(*genv(), SYM(KEYMAP), keymap);
+  env_set(*genv(), SYM(CURRENT_KEYMAP), keymap);
 
   Atom popup_buffer = make_buffer(env_create(nil, 0), ".popup");
   if (!bufferp(popup_buffer)) {
+    gcol_root_pop(1);
     MAKE_ERROR(err, ERROR_GENERIC,
                nil, "make_buffer() didn't return a buffer!",
                NULL);
@@ -2296,9 +2215,10 @@ Error builtin_read_prompted(Atom arguments, Atom *result) {
   free(string);
 
   // Restore keymap.
-  env_get(*genv(), make_sym("KEYMAP"), &keymap);
+  env_get(*genv(), SYM(KEYMAP), &keymap);
   alist_set(&keymap, make_string(LITE_KEYSTRING_RETURN), original_return_binding);
-  env_set(*genv(), make_sym("KEYMAP"), keymap);
+  env_set(*genv(), SYM(KEYMAP), keymap);
+  gcol_root_pop(1);
 
 #else /* #ifdef LITE_GFX */
 
@@ -2365,7 +2285,7 @@ Error builtin_change_font(Atom arguments, Atom *result) {
   }
   *result = nil;
   if (change_font(font_path.value.symbol, (size_t)font_size.value.integer) == 0) {
-    *result = make_sym("T");
+    *result = SYM(T);
   }
 #endif
   return ok;
@@ -2389,7 +2309,7 @@ Error builtin_change_font_size(Atom arguments, Atom *result) {
   }
   *result = nil;
   if (change_font_size((size_t)font_size.value.integer) == 0) {
-    *result = make_sym("T");
+    *result = SYM(T);
   }
 #endif
   return ok;
@@ -2480,7 +2400,7 @@ Error builtin_change_window_size(Atom arguments, Atom *result) {
                NULL);
     return err_type;
   }
-  *result = make_sym("T");
+  *result = SYM(T);
   change_window_size((size_t)width.value.integer, (size_t)height.value.integer);
 #endif
   return ok;
@@ -2515,14 +2435,14 @@ Error builtin_change_window_mode(Atom arguments, Atom *result) {
 
 static Atom get_active_window(void) {
   Atom window_list = nil;
-  Error err = env_get(*genv(), make_sym("WINDOWS"), &window_list);
+  Error err = env_get(*genv(), SYM(WINDOWS), &window_list);
   if (err.type) {
     print_error(err);
     return nil;
   }
 
   Atom active_window_index = nil;
-  err = env_get(*genv(), make_sym("ACTIVE-WINDOW-INDEX"), &active_window_index);
+  err = env_get(*genv(), SYM(ACTIVE_WINDOW_INDEX), &active_window_index);
   if (err.type) {
     active_window_index = make_int(0);
   }
@@ -2753,10 +2673,9 @@ Error builtin_cursor_keep_on_screen(Atom arguments, Atom *result) {
 #endif /* #ifdef LITE_GFX */
 }
 
-Atom terrible_copy_paste_implementation = { .type      = ATOM_TYPE_STRING,
-                                            .value     = { .symbol = "Paste and ye shall recieve." },
-                                            .galloc    = NULL,
-                                            .docstring = NULL };
+/// Whatever was most recently cut or copied. It's kept out of the
+/// garbage collector's hands, as nothing it marks refers to it.
+static char *terrible_copy_paste_implementation = NULL;
 
 const char *const builtin_clipboard_cut_name = "CLIPBOARD-CUT";
 const char *const builtin_clipboard_cut_docstring =
@@ -2783,12 +2702,12 @@ Error builtin_clipboard_cut(Atom arguments, Atom *result) {
       return err;
     }
     // TODO: This is a terrible copy and paste implementation!
-    terrible_copy_paste_implementation = make_string(region);
 #   ifdef LITE_GFX
     set_clipboard_utf8(region);
 #   endif
-    free(region);
-    *result = make_sym("T");
+    free(terrible_copy_paste_implementation);
+    terrible_copy_paste_implementation = region;
+    *result = SYM(T);
   }
   return ok;
 }
@@ -2811,12 +2730,12 @@ Error builtin_clipboard_copy(Atom arguments, Atom *result) {
   if (buffer_mark_active(*buffer.value.buffer)) {
     char *region = buffer_region(*buffer.value.buffer);
     // TODO: This is a terrible copy and paste implementation!
-    terrible_copy_paste_implementation = make_string(region);
 #   ifdef LITE_GFX
     set_clipboard_utf8(region);
 #   endif
-    free(region);
-    *result = make_sym("T");
+    free(terrible_copy_paste_implementation);
+    terrible_copy_paste_implementation = region;
+    *result = SYM(T);
   }
 
   return ok;
@@ -2850,11 +2769,14 @@ Error builtin_clipboard_paste(Atom arguments, Atom *result) {
       return ERROR_TYPE;
     }
     */
-    to_insert = terrible_copy_paste_implementation.value.symbol;
+    to_insert = terrible_copy_paste_implementation;
+    if (!to_insert) {
+      to_insert = "Paste and ye shall recieve.";
+    }
 # ifdef LITE_GFX
   }
 # endif
-  *result = make_sym("T");
+  *result = SYM(T);
   buffer_insert(buffer.value.buffer, to_insert);
 # ifdef LITE_GFX
   if (needs_freed) {
@@ -2877,7 +2799,7 @@ Error builtin_set_carriage_return_character(Atom arguments, Atom *result) {
 
 # ifdef LITE_GFX
   if (nilp(car(arguments)) || stringp(car(arguments)) || symbolp(car(arguments))) {
-    *result = make_sym("T");
+    *result = SYM(T);
     gui_ctx()->cr_char = nilp(car(arguments)) ? 0 : car(arguments).value.symbol[0];
     // Disallow control characters.
     if (gui_ctx()->cr_char < 32) {
@@ -2956,7 +2878,7 @@ Error builtin_shaders(Atom arguments, Atom *result) {
   }
   free(frag_shader);
   free(vert_shader);
-  *result = make_sym("T");
+  *result = SYM(T);
   return ok;
 #else
   *result = nil;
@@ -1,6 +1,8 @@
 #ifndef LITE_BUILTINS_H
 #define LITE_BUILTINS_H
 
+#include <stddef.h>
+
 struct Error;
 
 #define builtin(name)                                  \
@@ -8,9 +10,54 @@ struct Error;
   extern const char *const builtin_##name##_docstring; \
   struct Error builtin_##name(Atom arguments, Atom *result)
 
+/// A builtin that may also be called with it's arguments in a vector.
+#define vector_builtin(name)                            \
+  builtin(name);                                        \
+  extern const BuiltInVector builtin_##name##_vector
+
 struct Atom;
 typedef struct Atom Atom;
 
+#define BUILTIN_VECTOR_ARITY_MAX 3
+/// Any type of argument is accepted.
+#define BUILTIN_ANY_TYPE ATOM_TYPE_MAX
+
+/** A second calling convention for builtins that take a fixed number
+ *  of arguments: as a vector, rather than a list.
+ *
+ * The number of arguments and the type of each is declared once, here,
+ * and checked by builtin_vector_call() before FUNCTION is called. A
+ * caller that already has the arguments in an array (i.e. the stack of
+ * the bytecode virtual machine) needn't cons them into a list at all.
+ * The list calling convention, LIST, unpacks it's arguments and calls
+ * FUNCTION just the same.
+ */
+typedef struct BuiltInVector {
+  struct Error (*list)(Atom arguments, Atom *result);
+  struct Error (*function)(Atom *argv, Atom *result);
+  unsigned char arity;
+  /// Message and suggestion of the type error returned when an
+  /// argument is not of it's declared type.
+  const char *type_error;
+  const char *type_suggestion;
+  /// The type each argument must be, or BUILTIN_ANY_TYPE.
+  unsigned char types[BUILTIN_VECTOR_ARITY_MAX];
+} BuiltInVector;
+
+/// Make BUILTIN be found by builtin_vector().
+void builtin_vector_register(const BuiltInVector *builtin);
+
+/// Get the vector calling convention of the builtin with the list
+/// calling convention FUNCTION, or NULL if it has none.
+const BuiltInVector *builtin_vector(struct Error (*function)(Atom arguments, Atom *result));
+
+/** Call BUILTIN with the ARGC arguments in ARGV.
+ *
+ * The reference of any error returned by checking the arguments is
+ * a list of them.
+ */
+struct Error builtin_vector_call(const BuiltInVector *builtin, size_t argc, Atom *argv, Atom *result);
+
 builtin(quit_lisp);
 
 builtin(docstring);
@@ -19,63 +66,64 @@ builtin(tree_sitter_update);
 
 // TYPES
 
-builtin(nilp);
-builtin(pairp);
-builtin(symbolp);
-builtin(integerp);
-builtin(builtinp);
-builtin(closurep);
-builtin(macrop);
-builtin(stringp);
-builtin(bufferp);
-builtin(envp);
+vector_builtin(nilp);
+vector_builtin(pairp);
+vector_builtin(symbolp);
+vector_builtin(integerp);
+vector_builtin(builtinp);
+vector_builtin(closurep);
+vector_builtin(macrop);
+vector_builtin(stringp);
+vector_builtin(bufferp);
+vector_builtin(envp);
 
 // PAIRS
 
-builtin(cons);
-builtin(car);
-builtin(cdr);
-builtin(setcar);
-builtin(setcdr);
+vector_builtin(cons);
+vector_builtin(car);
+vector_builtin(cdr);
+vector_builtin(setcar);
+vector_builtin(setcdr);
 
 // LISTS
 
-builtin(member);
-builtin(length);
+vector_builtin(member);
+vector_builtin(length);
 
 // LOGICAL
 
-builtin(not);
-builtin(eq);
+vector_builtin(not);
+vector_builtin(eq);
 
-builtin(numeq);
-builtin(numnoteq);
-builtin(numlt);
-builtin(numlt_or_eq);
-builtin(numgt);
-builtin(numgt_or_eq);
+vector_builtin(numeq);
+vector_builtin(numnoteq);
+vector_builtin(numlt);
+vector_builtin(numlt_or_eq);
+vector_builtin(numgt);
+vector_builtin(numgt_or_eq);
 
 // MATHEMATICAL
 
-builtin(add);
-builtin(subtract);
-builtin(multiply);
-builtin(divide);
-builtin(remainder);
+vector_builtin(add);
+vector_builtin(subtract);
+vector_builtin(multiply);
+vector_builtin(divide);
+vector_builtin(remainder);
 
 // BITWISE
 
-builtin(bitand);
-builtin(bitor);
-builtin(bitxor);
-builtin(bitnot);
-builtin(bitshl);
-builtin(bitshr);
+vector_builtin(bitand);
+vector_builtin(bitor);
+vector_builtin(bitxor);
+vector_builtin(bitnot);
+vector_builtin(bitshl);
+vector_builtin(bitshr);
 
 // ENVIRONMENTS
 
 builtin(env_set);
 builtin(env_set_direct);
+builtin(env_remove_direct);
 builtin(env_get);
 builtin(env_get_direct);
 builtin(env_parent);
@@ -95,22 +143,23 @@ builtin(buffer_region_length);
 builtin(open_buffer);
 builtin(buffer_path);
 builtin(buffer_table);
-builtin(buffer_insert);
-builtin(buffer_remove);
-builtin(buffer_remove_forward);
+vector_builtin(close_buffer);
+vector_builtin(buffer_insert);
+vector_builtin(buffer_remove);
+vector_builtin(buffer_remove_forward);
 
-builtin(buffer_undo);
-builtin(buffer_redo);
+vector_builtin(buffer_undo);
+vector_builtin(buffer_redo);
 
-builtin(buffer_set_point);
-builtin(buffer_point);
+vector_builtin(buffer_set_point);
+vector_builtin(buffer_point);
 builtin(buffer_row_col);
 
-builtin(buffer_index);
-builtin(buffer_string);
-builtin(buffer_lines);
-builtin(buffer_line);
-builtin(buffer_current_line);
+vector_builtin(buffer_index);
+vector_builtin(buffer_string);
+vector_builtin(buffer_lines);
+vector_builtin(buffer_line);
+vector_builtin(buffer_current_line);
 
 builtin(buffer_seek_byte);
 builtin(buffer_seek_past_byte);
@@ -141,6 +190,7 @@ builtin(evaluate_file);
 builtin(apply);
 
 builtin(symbol_table);
+builtin(garbage_collector_statistics);
 builtin(print);
 builtin(prins);
 
@@ -173,5 +223,6 @@ builtin(shaders);
 builtin(cursor_keep_on_screen);
 
 #undef builtin
+#undef vector_builtin
 
 #endif /* LITE_BUILTINS_H */
@@ -0,0 +1,1250 @@
+#include <bytecode.h>
+
+#include <assert.h>
+#include <builtins.h>
+#include <environment.h>
+#include <error.h>
+#include <evaluation.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <types.h>
+#include <utility.h>
+
+/* Every instruction is an opcode followed by zero or more operand
+ * words. Stack effects are noted as (before -- after), top-most last.
+ */
+typedef enum Opcode {
+  /// CONSTANT k :: ( -- constants[k] )
+  OP_CONSTANT = 0,
+  /// NIL :: ( -- nil )
+  OP_NIL,
+  /// GET k cache :: ( -- value of symbol constants[k] )
+  OP_GET,
+  /// GET-LOCAL depth k slot :: ( -- value of symbol constants[k] )
+  /// The symbol is a parameter of the closure DEPTH environments up;
+  /// SLOT caches where it was last found within that environment.
+  OP_GET_LOCAL,
+  /// DEFINE k doc :: ( value -- constants[k] )
+  OP_DEFINE,
+  /// SET k doc :: ( value -- constants[k] )
+  OP_SET,
+  /// POP :: ( a -- )
+  OP_POP,
+  /// JUMP target :: ( -- )
+  OP_JUMP,
+  /// JUMP-IF-NIL target :: ( condition -- )
+  OP_JUMP_IF_NIL,
+  /// AND target :: ( a -- ) or ( nil -- nil ) and jump
+  OP_AND,
+  /// OR target :: ( nil -- ) or ( a -- a ) and jump
+  OP_OR,
+  /// WHILE target :: ( count condition -- count ) or ( count condition -- condition ) and jump
+  OP_WHILE,
+  /// LAMBDA k :: ( -- closure of constants[k] )
+  OP_LAMBDA,
+  /// OPERATOR site :: ( -- operator ), or run macro expansion of site.
+  OP_OPERATOR,
+  /// CHECK-OPERATOR site :: ( operator -- operator ), or run macro expansion of site.
+  OP_CHECK_OPERATOR,
+  /// EXPAND site :: ( -- value of macro expansion of site )
+  OP_EXPAND,
+  /// CALL n :: ( operator argument*n -- value )
+  OP_CALL,
+  /// TAIL-CALL n :: ( operator argument*n -- value ), a closure
+  /// replaces the frame it's called from instead of returning to it.
+  OP_TAIL_CALL,
+  /// RETURN :: ( value -- )
+  OP_RETURN,
+  /// ENV :: ( -- environment )
+  OP_ENV,
+  /// EVALUATE :: ( expression -- value )
+  OP_EVALUATE,
+  /// ERROR k :: ( -- ), stops evaluation with message constants[k].
+  OP_ERROR,
+  /// INTERPRET k :: ( -- value of constants[k] evaluated by the interpreter )
+  OP_INTERPRET,
+  OP_COUNT,
+} Opcode;
+
+typedef unsigned int Instruction;
+
+#define NO_DOCSTRING ((Instruction)-1)
+#define NO_SLOT ((Instruction)-1)
+
+struct Bytecode;
+
+/// An application within a body that may turn out to be a macro.
+typedef struct BytecodeSite {
+  /// The entire form, `(OPERATOR . ARGUMENTS)`.
+  Atom form;
+  /// The macro that EXPANSION was expanded by, or nil.
+  Atom macro;
+  struct Bytecode *expansion;
+  /// Where to continue once an expansion that replaced a call returns.
+  size_t skip;
+  /// Non-zero iff the value of the application is returned as is.
+  char tail;
+  /// Of the operator, when it is a symbol.
+  EnvironmentCache cache;
+} BytecodeSite;
+
+typedef struct Bytecode {
+  struct Bytecode *next;
+  /// The next closure bytecode compiled from the same body, under other
+  /// scopes or for other parameters.
+  struct Bytecode *same_body;
+  /// Non-zero for the body of a closure, zero for a macro expansion.
+  char closure;
+  /// Non-zero iff the value of this code is returned as is by the
+  /// frame it's run on top of (always true of a closure body).
+  char tail;
+  char mark;
+  Atom parameters;
+  Atom body;
+  /// Parameter lists of every closure this code is lexically within,
+  /// innermost first. Their environments are where these are bound.
+  Atom scopes;
+  Instruction *code;
+  size_t code_count;
+  size_t code_capacity;
+  Atom *constants;
+  size_t constants_count;
+  size_t constants_capacity;
+  BytecodeSite *sites;
+  size_t sites_count;
+  size_t sites_capacity;
+  EnvironmentCache *caches;
+  size_t caches_count;
+  size_t caches_capacity;
+  /// Maximum amount of values this code ever has on the stack at once.
+  size_t stack_size;
+} Bytecode;
+
+#define GROW(array, count, capacity) do {                               \
+    if ((count) >= (capacity)) {                                        \
+      size_t grow_capacity = (capacity) ? (capacity) * 2 : 16;          \
+      void *grow_array = realloc((array), grow_capacity * sizeof(*(array))); \
+      if (!grow_array) {                                                \
+        fprintf(stderr, "BYTECODE: Could not allocate memory.\n");     \
+        exit(1);                                                        \
+      }                                                                 \
+      (array) = grow_array;                                             \
+      (capacity) = grow_capacity;                                       \
+    }                                                                   \
+  } while (0)
+
+/// Every piece of compiled bytecode, for sweeping.
+static Bytecode *bytecode_allocations = NULL;
+
+/// Closure bytecode, keyed by body pair. Bytecode compiled from the
+/// same body more than once is chained through `same_body`.
+static Bytecode **bytecode_table = NULL;
+static size_t bytecode_table_count = 0;
+static size_t bytecode_table_capacity = 0;
+
+static size_t bytecode_hash(Pair *body) {
+  uint64_t key = (uint64_t)(uintptr_t)body;
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return (size_t)key;
+}
+
+static Bytecode **bytecode_table_slot(Pair *body) {
+  size_t mask = bytecode_table_capacity - 1;
+  size_t index = bytecode_hash(body) & mask;
+  while (bytecode_table[index] && bytecode_table[index]->body.value.pair != body) {
+    index = (index + 1) & mask;
+  }
+  return bytecode_table + index;
+}
+
+static void bytecode_table_insert(Bytecode *chunk) {
+  if ((bytecode_table_count + 1) * 2 > bytecode_table_capacity) {
+    Bytecode **old_table = bytecode_table;
+    size_t old_capacity = bytecode_table_capacity;
+    bytecode_table_capacity = old_capacity ? old_capacity * 2 : 64;
+    bytecode_table = calloc(bytecode_table_capacity, sizeof(Bytecode *));
+    if (!bytecode_table) {
+      fprintf(stderr, "BYTECODE: Could not allocate memory for bytecode table.\n");
+      exit(1);
+    }
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old_table[i]) {
+        *bytecode_table_slot(old_table[i]->body.value.pair) = old_table[i];
+      }
+    }
+    free(old_table);
+  }
+  Bytecode **slot = bytecode_table_slot(chunk->body.value.pair);
+  if (!*slot) { bytecode_table_count += 1; }
+  chunk->same_body = *slot;
+  *slot = chunk;
+}
+
+/// Return the first of the closure bytecode compiled from BODY, or NULL.
+static Bytecode *bytecode_table_get(Atom body) {
+  if (!bytecode_table || !pairp(body)) { return NULL; }
+  return *bytecode_table_slot(body.value.pair);
+}
+
+static Bytecode *bytecode_create(Atom parameters, Atom body, Atom scopes, char closure, char tail) {
+  Bytecode *chunk = calloc(1, sizeof(Bytecode));
+  if (!chunk) {
+    fprintf(stderr, "BYTECODE: Could not allocate memory for bytecode.\n");
+    exit(1);
+  }
+  chunk->closure = closure;
+  chunk->tail = tail;
+  chunk->parameters = parameters;
+  chunk->body = body;
+  chunk->scopes = scopes;
+  chunk->next = bytecode_allocations;
+  bytecode_allocations = chunk;
+  return chunk;
+}
+
+static void bytecode_free(Bytecode *chunk) {
+  free(chunk->code);
+  free(chunk->constants);
+  free(chunk->sites);
+  free(chunk->caches);
+  free(chunk);
+}
+
+//================================================================ BEG compiler
+
+typedef struct Compiler {
+  Bytecode *chunk;
+  /// Used to recognise macro applications at compile time.
+  Atom environment;
+  /// See Bytecode.scopes. Parameters also shadow macros.
+  Atom scopes;
+  size_t depth;
+} Compiler;
+
+static size_t emit(Compiler *c, Instruction word) {
+  Bytecode *chunk = c->chunk;
+  GROW(chunk->code, chunk->code_count, chunk->code_capacity);
+  chunk->code[chunk->code_count] = word;
+  return chunk->code_count++;
+}
+
+static void patch(Compiler *c, size_t index) {
+  c->chunk->code[index] = (Instruction)c->chunk->code_count;
+}
+
+static void stack_effect(Compiler *c, int effect) {
+  if (effect < 0) {
+    assert(c->depth >= (size_t)-effect && "Bytecode compiler stack underflow.");
+    c->depth -= (size_t)-effect;
+    return;
+  }
+  c->depth += (size_t)effect;
+  if (c->depth > c->chunk->stack_size) {
+    c->chunk->stack_size = c->depth;
+  }
+}
+
+static Instruction add_constant(Compiler *c, Atom constant) {
+  Bytecode *chunk = c->chunk;
+  GROW(chunk->constants, chunk->constants_count, chunk->constants_capacity);
+  chunk->constants[chunk->constants_count] = constant;
+  return (Instruction)chunk->constants_count++;
+}
+
+static Instruction add_site(Compiler *c, Atom form) {
+  Bytecode *chunk = c->chunk;
+  GROW(chunk->sites, chunk->sites_count, chunk->sites_capacity);
+  BytecodeSite *site = chunk->sites + chunk->sites_count;
+  site->form = form;
+  site->macro = nil;
+  site->expansion = NULL;
+  site->skip = 0;
+  site->tail = 0;
+  site->cache.version = 0;
+  return (Instruction)chunk->sites_count++;
+}
+
+static Instruction add_cache(Compiler *c) {
+  Bytecode *chunk = c->chunk;
+  GROW(chunk->caches, chunk->caches_count, chunk->caches_capacity);
+  chunk->caches[chunk->caches_count].version = 0;
+  return (Instruction)chunk->caches_count++;
+}
+
+static size_t form_length(Atom list) {
+  size_t length = 0;
+  for (; pairp(list); list = cdr(list)) { ++length; }
+  return length;
+}
+
+/// Return non-zero iff A and B are the very same atom.
+static int atom_identical(Atom a, Atom b) {
+  return a.type == b.type && a.value.pair == b.value.pair;
+}
+
+/// Return non-zero iff the lists of parameter lists A and B are made
+/// of the very same parameter lists.
+static int scopes_identical(Atom a, Atom b) {
+  for (; pairp(a) && pairp(b); a = cdr(a), b = cdr(b)) {
+    if (!atom_identical(car(a), car(b))) { return 0; }
+  }
+  return nilp(a) && nilp(b);
+}
+
+/// Return non-zero iff SYMBOL is a parameter of the closure DEPTH
+/// scopes up, setting DEPTH, or zero if it isn't a parameter at all.
+static int compile_resolve(Compiler *c, Atom symbol, Instruction *depth) {
+  *depth = 0;
+  for (Atom scope = c->scopes; pairp(scope); scope = cdr(scope), ++*depth) {
+    for (Atom it = car(scope); !nilp(it); it = cdr(it)) {
+      if (symbolp(it)) {
+        if (it.value.symbol == symbol.value.symbol) { return 1; }
+        break;
+      }
+      if (car(it).value.symbol == symbol.value.symbol) { return 1; }
+    }
+  }
+  return 0;
+}
+
+/// Return non-zero iff SYMBOL is bound to a macro when compiling.
+static int compile_time_macrop(Compiler *c, Atom symbol) {
+  Instruction depth = 0;
+  if (compile_resolve(c, symbol, &depth)) { return 0; }
+  Atom value = nil;
+  Error err = env_get(c->environment, symbol, &value);
+  return !err.type && macrop(value);
+}
+
+/** Compile EXPR such that it's value is left on the stack.
+ *
+ * @param tail Non-zero iff EXPR is in tail position: it's value is
+ *             what the code being compiled returns.
+ */
+static void compile_expression(Compiler *c, Atom expr, char tail);
+
+/// Leave the interpreter to evaluate EXPR, including reporting any errors.
+static void compile_interpret(Compiler *c, Atom expr) {
+  emit(c, OP_INTERPRET);
+  emit(c, add_constant(c, expr));
+  stack_effect(c, 1);
+}
+
+/// Compile BODY such that the value of it's last expression is left on the stack.
+static void compile_sequence(Compiler *c, Atom body, char tail) {
+  if (nilp(body)) {
+    emit(c, OP_NIL);
+    stack_effect(c, 1);
+    return;
+  }
+  for (;;) {
+    Atom expr = car(body);
+    body = cdr(body);
+    compile_expression(c, expr, tail && nilp(body));
+    if (nilp(body)) { break; }
+    emit(c, OP_POP);
+    stack_effect(c, -1);
+  }
+}
+
+static void compile_application(Compiler *c, Atom expr, char tail) {
+  Atom operator = car(expr);
+  Atom arguments = cdr(expr);
+  Instruction site = add_site(c, expr);
+  c->chunk->sites[site].tail = tail;
+  if (symbolp(operator)) {
+    if (compile_time_macrop(c, operator)) {
+      emit(c, OP_EXPAND);
+      emit(c, site);
+      stack_effect(c, 1);
+      return;
+    }
+    emit(c, OP_OPERATOR);
+    emit(c, site);
+    stack_effect(c, 1);
+  } else {
+    compile_expression(c, operator, 0);
+    emit(c, OP_CHECK_OPERATOR);
+    emit(c, site);
+  }
+  Instruction argument_count = 0;
+  for (; !nilp(arguments); arguments = cdr(arguments)) {
+    compile_expression(c, car(arguments), 0);
+    ++argument_count;
+  }
+  emit(c, tail ? OP_TAIL_CALL : OP_CALL);
+  emit(c, argument_count);
+  stack_effect(c, -(int)argument_count);
+  c->chunk->sites[site].skip = c->chunk->code_count;
+}
+
+
+static Bytecode *compile(Atom parameters, Atom body, Atom environment, Atom scopes,
+                         char closure, char tail);
+
+static void compile_expression(Compiler *c, Atom expr, char tail) {
+  Instruction depth = 0;
+  if (symbolp(expr) && compile_resolve(c, expr, &depth)) {
+    emit(c, OP_GET_LOCAL);
+    emit(c, depth);
+    emit(c, add_constant(c, expr));
+    emit(c, NO_SLOT);
+    stack_effect(c, 1);
+    return;
+  }
+  if (symbolp(expr)) {
+    emit(c, OP_GET);
+    emit(c, add_constant(c, expr));
+    emit(c, add_cache(c));
+    stack_effect(c, 1);
+    return;
+  }
+  if (nilp(expr)) {
+    emit(c, OP_NIL);
+    stack_effect(c, 1);
+    return;
+  }
+  if (!pairp(expr)) {
+    emit(c, OP_CONSTANT);
+    emit(c, add_constant(c, expr));
+    stack_effect(c, 1);
+    return;
+  }
+  if (!listp(expr)) {
+    compile_interpret(c, expr);
+    return;
+  }
+
+  Atom operator = car(expr);
+  Atom arguments = cdr(expr);
+  size_t argument_count = form_length(arguments);
+
+  if (builtinp(operator)) {
+    // The interpreter calls a builtin in operator position with the
+    // arguments as they are, unevaluated.
+    compile_interpret(c, expr);
+    return;
+  }
+  if (!symbolp(operator)) {
+    compile_application(c, expr, tail);
+    return;
+  }
+
+  // Special forms. Anything malformed is left to the interpreter, so
+  // that it may report the error the same as it always has.
+  SpecialForm form = special_form(operator);
+  if (form == SPECIAL_FORM_QUOTE) {
+    if (argument_count != 1) {
+      compile_interpret(c, expr);
+      return;
+    }
+    emit(c, OP_CONSTANT);
+    emit(c, add_constant(c, car(arguments)));
+    stack_effect(c, 1);
+  } else if (form == SPECIAL_FORM_QUASIQUOTE) {
+    Atom expansion = nil;
+    if (argument_count != 1
+        || evaluate_quasiquote_expand(car(arguments), &expansion).type) {
+      compile_interpret(c, expr);
+      return;
+    }
+    compile_expression(c, expansion, tail);
+  } else if (form == SPECIAL_FORM_DEFINE || form == SPECIAL_FORM_SET) {
+    if (argument_count < 2 || argument_count > 3
+        || !symbolp(car(arguments))
+        || (argument_count == 3 && !stringp(car(cdr(cdr(arguments))))))
+      {
+        compile_interpret(c, expr);
+        return;
+      }
+    compile_expression(c, car(cdr(arguments)), 0);
+    emit(c, form == SPECIAL_FORM_DEFINE ? OP_DEFINE : OP_SET);
+    emit(c, add_constant(c, car(arguments)));
+    emit(c, argument_count == 3
+         ? add_constant(c, car(cdr(cdr(arguments))))
+         : NO_DOCSTRING);
+  } else if (form == SPECIAL_FORM_LAMBDA) {
+    if (argument_count < 2) {
+      compile_interpret(c, expr);
+      return;
+    }
+    emit(c, OP_LAMBDA);
+    emit(c, add_constant(c, arguments));
+    stack_effect(c, 1);
+    // Compile the body now, while where it is lexically is known.
+    Atom body = cdr(arguments);
+    if (pairp(body)) {
+      Bytecode *chunk = bytecode_table_get(body);
+      while (chunk && !(atom_identical(chunk->parameters, car(arguments))
+                        && scopes_identical(cdr(chunk->scopes), c->scopes)))
+        {
+          chunk = chunk->same_body;
+        }
+      if (!chunk) {
+        bytecode_table_insert(compile(car(arguments), body, c->environment, c->scopes, 1, 1));
+      }
+    }
+  } else if (form == SPECIAL_FORM_IF) {
+    if (argument_count != 3) {
+      compile_interpret(c, expr);
+      return;
+    }
+    compile_expression(c, car(arguments), 0);
+    emit(c, OP_JUMP_IF_NIL);
+    size_t to_else = emit(c, 0);
+    stack_effect(c, -1);
+    compile_expression(c, car(cdr(arguments)), tail);
+    emit(c, OP_JUMP);
+    size_t to_end = emit(c, 0);
+    stack_effect(c, -1);
+    patch(c, to_else);
+    compile_expression(c, car(cdr(cdr(arguments))), tail);
+    patch(c, to_end);
+  } else if (form == SPECIAL_FORM_WHILE) {
+    if (argument_count < 2) {
+      compile_interpret(c, expr);
+      return;
+    }
+    // Recurse count lives underneath the condition.
+    emit(c, OP_NIL);
+    stack_effect(c, 1);
+    size_t top = c->chunk->code_count;
+    compile_expression(c, car(arguments), 0);
+    emit(c, OP_WHILE);
+    size_t to_end = emit(c, 0);
+    stack_effect(c, -1);
+    compile_sequence(c, cdr(arguments), 0);
+    emit(c, OP_POP);
+    stack_effect(c, -1);
+    emit(c, OP_JUMP);
+    emit(c, (Instruction)top);
+    patch(c, to_end);
+  } else if (form == SPECIAL_FORM_PROGN) {
+    compile_sequence(c, arguments, tail);
+  } else if (form == SPECIAL_FORM_EVALUATE) {
+    if (argument_count != 1) {
+      compile_interpret(c, expr);
+      return;
+    }
+    compile_expression(c, car(arguments), 0);
+    emit(c, OP_EVALUATE);
+  } else if (form == SPECIAL_FORM_ENV) {
+    if (argument_count != 0) {
+      compile_interpret(c, expr);
+      return;
+    }
+    emit(c, OP_ENV);
+    stack_effect(c, 1);
+  } else if (form == SPECIAL_FORM_ERROR) {
+    if (argument_count != 1 || !stringp(car(arguments))) {
+      compile_interpret(c, expr);
+      return;
+    }
+    emit(c, OP_ERROR);
+    emit(c, add_constant(c, car(arguments)));
+    stack_effect(c, 1);
+  } else if (form == SPECIAL_FORM_OR || form == SPECIAL_FORM_AND) {
+    if (nilp(arguments)) {
+      emit(c, OP_NIL);
+      stack_effect(c, 1);
+      return;
+    }
+    Opcode opcode = form == SPECIAL_FORM_OR ? OP_OR : OP_AND;
+    size_t *to_end = calloc(argument_count, sizeof(size_t));
+    if (!to_end) {
+      fprintf(stderr, "BYTECODE: Could not allocate memory.\n");
+      exit(1);
+    }
+    size_t jumps = 0;
+    for (; !nilp(cdr(arguments)); arguments = cdr(arguments)) {
+      compile_expression(c, car(arguments), 0);
+      emit(c, opcode);
+      to_end[jumps++] = emit(c, 0);
+      stack_effect(c, -1);
+    }
+    compile_expression(c, car(arguments), tail);
+    while (jumps) { patch(c, to_end[--jumps]); }
+    free(to_end);
+  } else if (form == SPECIAL_FORM_MACRO
+             || form == SPECIAL_FORM_QUIT_COMPLETELY) {
+    compile_interpret(c, expr);
+  } else {
+    compile_application(c, expr, tail);
+  }
+}
+
+#ifdef LITE_DBG
+static const char *const opcode_names[OP_COUNT] = {
+  "CONSTANT", "NIL", "GET", "GET-LOCAL", "DEFINE", "SET", "POP", "JUMP", "JUMP-IF-NIL",
+  "AND", "OR", "WHILE", "LAMBDA", "OPERATOR", "CHECK-OPERATOR", "EXPAND",
+  "CALL", "TAIL-CALL", "RETURN", "ENV", "EVALUATE", "ERROR", "INTERPRET",
+};
+
+static void print_bytecode(Bytecode *chunk) {
+  printf("Bytecode for ");
+  print_atom(chunk->closure ? cons(chunk->parameters, chunk->body) : chunk->body);
+  printf("\n  stack size: %zu\n", chunk->stack_size);
+  for (size_t pc = 0; pc < chunk->code_count;) {
+    Opcode opcode = (Opcode)chunk->code[pc];
+    printf("  %4zu  %s", pc, opcode_names[opcode]);
+    ++pc;
+    switch (opcode) {
+    case OP_GET_LOCAL:
+      printf(" %u ", chunk->code[pc++]);
+      print_atom(chunk->constants[chunk->code[pc++]]);
+      ++pc;
+      break;
+    case OP_GET:
+      putchar(' ');
+      print_atom(chunk->constants[chunk->code[pc++]]);
+      ++pc;
+      break;
+    case OP_CONSTANT: case OP_LAMBDA: case OP_ERROR: case OP_INTERPRET:
+      putchar(' ');
+      print_atom(chunk->constants[chunk->code[pc++]]);
+      break;
+    case OP_DEFINE: case OP_SET:
+      putchar(' ');
+      print_atom(chunk->constants[chunk->code[pc++]]);
+      if (chunk->code[pc] != NO_DOCSTRING) { printf(" (documented)"); }
+      ++pc;
+      break;
+    case OP_OPERATOR: case OP_CHECK_OPERATOR: case OP_EXPAND:
+      putchar(' ');
+      print_atom(chunk->sites[chunk->code[pc++]].form);
+      break;
+    case OP_JUMP: case OP_JUMP_IF_NIL: case OP_AND: case OP_OR: case OP_WHILE:
+    case OP_CALL: case OP_TAIL_CALL:
+      printf(" %u", chunk->code[pc++]);
+      break;
+    default:
+      break;
+    }
+    putchar('\n');
+  }
+}
+#endif /* #ifdef LITE_DBG */
+
+/** Compile BODY into bytecode.
+ *
+ * @param scopes The scopes BODY is lexically within, not including
+ *               PARAMETERS. Nil if unknown, in which case only
+ *               PARAMETERS are resolved lexically.
+ * @param closure Non-zero iff BODY is the body of a closure taking
+ *                PARAMETERS, rather than a single expression.
+ */
+static Bytecode *compile(Atom parameters, Atom body, Atom environment, Atom scopes,
+                         char closure, char tail)
+{
+  if (closure) { scopes = cons(parameters, scopes); }
+  Compiler c;
+  c.chunk = bytecode_create(parameters, body, scopes, closure, tail);
+  c.environment = environment;
+  c.scopes = scopes;
+  c.depth = 0;
+  if (closure) {
+    compile_sequence(&c, body, tail);
+  } else {
+    compile_expression(&c, body, tail);
+  }
+  emit(&c, OP_RETURN);
+# ifdef LITE_DBG
+  if (env_non_nil(*genv(), make_sym("DEBUG/BYTECODE"))) {
+    print_bytecode(c.chunk);
+  }
+# endif
+  return c.chunk;
+}
+
+/// Return non-zero iff SCOPES are the parameter lists of the closures
+/// ENVIRONMENT was made to call, and of those it's parent was made to
+/// call, and so on.
+///
+/// An environment that wasn't made for a call passes for one made to
+/// call a closure without parameters, but as nothing is ever resolved
+/// to such a scope, that makes no difference.
+static int scopes_bound_in(Atom scopes, Atom environment) {
+  for (; pairp(scopes); scopes = cdr(scopes)) {
+    if (!envp(environment)
+        || !atom_identical(environment.value.env->parameters, car(scopes)))
+      {
+        return 0;
+      }
+    environment = environment.value.env->parent;
+  }
+  return 1;
+}
+
+static Bytecode *bytecode_of(Atom closure) {
+  Atom parameters = car(cdr(closure));
+  Atom body = cdr(cdr(closure));
+  if (!pairp(body)) {
+    return compile(parameters, body, car(closure), nil, 1, 1);
+  }
+  // The same body may have been compiled for other parameters, or
+  // within other closures (i.e. a quoted LAMBDA form evaluated in more
+  // than one place); only use bytecode whose parameter references were
+  // resolved to the environments this closure is within.
+  Bytecode *chunk = bytecode_table_get(body);
+  while (chunk && !(atom_identical(chunk->parameters, parameters)
+                    && scopes_bound_in(cdr(chunk->scopes), car(closure))))
+    {
+      chunk = chunk->same_body;
+    }
+  if (!chunk) {
+    chunk = compile(parameters, body, car(closure), nil, 1, 1);
+    bytecode_table_insert(chunk);
+  }
+  return chunk;
+}
+
+//================================================================ END compiler
+
+//================================================================ BEG virtual_machine
+
+typedef struct VMFrame {
+  Bytecode *chunk;
+  size_t pc;
+  /// Index of the first value on the stack belonging to this frame.
+  size_t base;
+  Atom environment;
+} VMFrame;
+
+static Atom *vm_stack = NULL;
+static size_t vm_stack_count = 0;
+static size_t vm_stack_capacity = 0;
+
+static VMFrame *vm_frames = NULL;
+static size_t vm_frames_count = 0;
+static size_t vm_frames_capacity = 0;
+
+#define FRAME (vm_frames[vm_frames_count - 1])
+#define PUSH(atom) (vm_stack[vm_stack_count++] = (atom))
+#define POP() (vm_stack[--vm_stack_count])
+#define TOP (vm_stack[vm_stack_count - 1])
+
+static void vm_reserve(size_t count) {
+  while (vm_stack_count + count > vm_stack_capacity) {
+    GROW(vm_stack, vm_stack_capacity, vm_stack_capacity);
+  }
+}
+
+static void vm_push_frame(Bytecode *chunk, Atom environment) {
+  GROW(vm_frames, vm_frames_count, vm_frames_capacity);
+  VMFrame *frame = vm_frames + vm_frames_count++;
+  frame->chunk = chunk;
+  frame->pc = 0;
+  frame->base = vm_stack_count;
+  frame->environment = environment;
+  vm_reserve(chunk->stack_size + 1);
+}
+
+/// Return a list of the COUNT values on the stack starting at FIRST.
+static Atom vm_list(size_t first, size_t count) {
+  Atom list = nil;
+  for (size_t i = first + count; i > first; --i) {
+    list = cons(vm_stack[i - 1], list);
+  }
+  return list;
+}
+
+static Error vm_bind_arguments(Atom environment, Atom argument_names, size_t first, size_t count) {
+  size_t index = 0;
+  while (!nilp(argument_names)) {
+    // Handle variadic arguments.
+    if (symbolp(argument_names)) {
+      env_set(environment, argument_names, vm_list(first + index, count - index));
+      index = count;
+      break;
+    }
+    if (index >= count) {
+      MAKE_ERROR(error_args, ERROR_ARGUMENTS, vm_list(first, count),
+                 "Could not bind arguments.",
+                 "Not enough arguments passed.");
+      return error_args;
+    }
+    env_set(environment, car(argument_names), vm_stack[first + index]);
+    argument_names = cdr(argument_names);
+    ++index;
+  }
+  if (index < count) {
+    MAKE_ERROR(error_args, ERROR_ARGUMENTS, vm_list(first, count),
+               "Could not bind arguments.",
+               "Too many arguments passed.");
+    return error_args;
+  }
+  return ok;
+}
+
+/** Apply the operator on the stack to the ARGUMENT-COUNT values above it.
+ *
+ * @param tail Non-zero iff the current frame would return the value of
+ *             the application as is, in which case a closure is run in
+ *             place of the current frame rather than on top of it.
+ */
+static Error vm_call(size_t argument_count, Atom environment, char tail) {
+  size_t operator_index = vm_stack_count - argument_count - 1;
+  Atom operator = vm_stack[operator_index];
+  Atom closure = nil;
+  if (builtinp(operator)
+      && operator.value.builtin->function == builtin_apply
+      && argument_count == 2
+      && evaluate_apply_target(vm_stack[operator_index + 1],
+                               vm_stack[operator_index + 2],
+                               &closure))
+    {
+      // Call the closure directly, with the arguments spread out on
+      // the stack, instead of recursing through builtin_apply().
+      Atom arguments = vm_stack[operator_index + 2];
+      argument_count = form_length(arguments);
+      vm_stack_count = operator_index;
+      vm_reserve(argument_count + 1);
+      PUSH(closure);
+      for (; pairp(arguments); arguments = cdr(arguments)) {
+        PUSH(car(arguments));
+      }
+      operator = closure;
+    }
+  if (builtinp(operator)) {
+    const BuiltInVector *vector = builtin_vector(operator.value.builtin->function);
+    if (vector) {
+      // The arguments are already a vector, right on the stack.
+      Atom result = nil;
+      Error err = builtin_vector_call(vector, argument_count,
+                                      vm_stack + operator_index + 1, &result);
+      if (err.type) {
+        if (err.type == ERROR_ARGUMENTS) {
+          err.ref = cons(operator, err.ref);
+        }
+        return err;
+      }
+      vm_stack_count = operator_index;
+      PUSH(result);
+      return ok;
+    }
+    Atom arguments = vm_list(operator_index + 1, argument_count);
+    // Builtins that require access to the environment get it added here.
+    if (operator.value.builtin->function == builtin_docstring) {
+      arguments = cons(environment, arguments);
+    }
+    // Keep the arguments reachable; some builtins evaluate more LISP.
+    vm_reserve(1);
+    PUSH(arguments);
+    Atom result = nil;
+    Error err = (*operator.value.builtin->function)(arguments, &result);
+    if (err.type) {
+      if (err.type == ERROR_ARGUMENTS) {
+        err.ref = cons(operator, arguments);
+      }
+      return err;
+    }
+    vm_stack_count = operator_index;
+    PUSH(result);
+    return ok;
+  }
+  if (closurep(operator)) {
+    Bytecode *chunk = bytecode_of(operator);
+    Atom closure_environment = env_create_call(car(operator), car(cdr(operator)));
+    Error err = vm_bind_arguments(closure_environment, car(cdr(operator)),
+                                  operator_index + 1, argument_count);
+    if (err.type) { return err; }
+    vm_stack_count = operator_index;
+    if (tail) {
+      // Nothing is left to do in the current frame, nor in any macro
+      // expansion frames it is the tail of; reuse the closure frame
+      // beneath them.
+      while (!FRAME.chunk->closure) { --vm_frames_count; }
+      vm_stack_count = FRAME.base;
+      FRAME.chunk = chunk;
+      FRAME.pc = 0;
+      FRAME.environment = closure_environment;
+      vm_reserve(chunk->stack_size + 1);
+      return ok;
+    }
+    vm_push_frame(chunk, closure_environment);
+    return ok;
+  }
+  MAKE_ERROR(err, ERROR_TYPE
+             , operator
+             , "APPLY: Expected operator type of #<BUILTIN> or #<CLOSURE>."
+             , NULL);
+  return err;
+}
+
+/// Run the expansion of the macro application at SITE within CHUNK in
+/// place, expanding it first if it hasn't been already by MACRO.
+static Error vm_expand(Bytecode *chunk, Instruction site, Atom macro) {
+  if (!chunk->sites[site].expansion
+      || chunk->sites[site].macro.value.pair != macro.value.pair)
+    {
+      Atom expansion = nil;
+      Error err = evaluate_macro_expand(macro, cdr(chunk->sites[site].form), &expansion);
+      if (err.type) { return err; }
+      chunk->sites[site].expansion = compile(nil, expansion, FRAME.environment, chunk->scopes,
+                                             0, chunk->sites[site].tail);
+      chunk->sites[site].macro = macro;
+    }
+  vm_push_frame(chunk->sites[site].expansion, FRAME.environment);
+  return ok;
+}
+
+/// Get the value of SYMBOL, a parameter of the closure DEPTH
+/// environments up from the current frame's, first trying where SLOT
+/// says it was found last time.
+HOTFUNCTION
+static Error vm_get_local(Instruction depth, Atom symbol, Instruction *slot, Atom *value) {
+  Atom environment = FRAME.environment;
+  for (; depth && envp(environment); --depth) {
+    // It may have been bound in between at run-time (i.e. with
+    // ENV-SET-DIRECT), shadowing the parameter.
+    EnvironmentValue *binding = env_binding(environment, symbol);
+    if (binding) {
+      *value = binding->value;
+      return ok;
+    }
+    environment = environment.value.env->parent;
+  }
+  if (envp(environment)) {
+    Environment *env = environment.value.env;
+    if (*slot < env->data_capacity && env->data[*slot].key == symbol.value.symbol) {
+      *value = env->data[*slot].value;
+      return ok;
+    }
+    EnvironmentValue *binding = env_binding(environment, symbol);
+    if (binding) {
+      *slot = (Instruction)(binding - env->data);
+      *value = binding->value;
+      return ok;
+    }
+  }
+  // Not where it lexically should be; the closure must have been
+  // created somewhere else, so look it up like any other symbol.
+  return env_get(FRAME.environment, symbol, value);
+}
+
+/// Count a step of evaluation, possibly collecting garbage.
+/// Return non-zero iff the user has quit.
+static int vm_safepoint(void) {
+  if (user_quit) { return 1; }
+  evaluation_gcol_step();
+  return 0;
+}
+
+static Error vm_run(size_t frames_base, size_t stack_base, Atom *result, char *aborted) {
+  Error err = ok;
+  while (vm_frames_count > frames_base) {
+    Bytecode *chunk = FRAME.chunk;
+    const Instruction *code = chunk->code;
+    switch ((Opcode)code[FRAME.pc++]) {
+    case OP_CONSTANT:
+      PUSH(chunk->constants[code[FRAME.pc++]]);
+      break;
+    case OP_NIL:
+      PUSH(nil);
+      break;
+    case OP_GET: {
+      Atom value = nil;
+      Atom symbol = chunk->constants[code[FRAME.pc++]];
+      err = env_get_cached(FRAME.environment, symbol, chunk->caches + code[FRAME.pc++], &value);
+      if (err.type) { goto fail; }
+      PUSH(value);
+      break;
+    }
+    case OP_GET_LOCAL: {
+      Instruction depth = code[FRAME.pc++];
+      Atom symbol = chunk->constants[code[FRAME.pc++]];
+      Atom value = nil;
+      err = vm_get_local(depth, symbol, chunk->code + FRAME.pc++, &value);
+      if (err.type) { goto fail; }
+      PUSH(value);
+      break;
+    }
+    case OP_DEFINE:
+    case OP_SET: {
+      Opcode opcode = (Opcode)code[FRAME.pc - 1];
+      Atom symbol = chunk->constants[code[FRAME.pc++]];
+      Instruction docstring = code[FRAME.pc++];
+      Atom value = TOP;
+      if (docstring != NO_DOCSTRING) {
+        symbol_set_docstring(symbol, chunk->constants[docstring].value.symbol);
+      }
+      if (opcode == OP_DEFINE) {
+        Atom containing = env_get_containing(FRAME.environment, symbol);
+        err = env_set(nilp(containing) ? FRAME.environment : containing, symbol, value);
+      } else {
+        err = env_set(*genv(), symbol, value);
+      }
+      if (err.type) { goto fail; }
+      TOP = symbol;
+      break;
+    }
+    case OP_POP:
+      --vm_stack_count;
+      break;
+    case OP_JUMP: {
+      size_t target = code[FRAME.pc];
+      // Only loops jump backwards.
+      if (target < FRAME.pc && vm_safepoint()) { goto quit; }
+      FRAME.pc = target;
+      break;
+    }
+    case OP_JUMP_IF_NIL: {
+      size_t target = code[FRAME.pc++];
+      if (nilp(POP())) { FRAME.pc = target; }
+      break;
+    }
+    case OP_AND: {
+      size_t target = code[FRAME.pc++];
+      if (nilp(TOP)) { FRAME.pc = target; }
+      else { --vm_stack_count; }
+      break;
+    }
+    case OP_OR: {
+      size_t target = code[FRAME.pc++];
+      if (!nilp(TOP)) { FRAME.pc = target; }
+      else { --vm_stack_count; }
+      break;
+    }
+    case OP_WHILE: {
+      size_t target = code[FRAME.pc++];
+      Atom condition = TOP;
+      Atom recurse_count = vm_stack[vm_stack_count - 2];
+      if (!integerp(recurse_count)) {
+        recurse_count = make_int(0);
+      } else {
+        recurse_count.value.integer += 1;
+      }
+      // If condition is nil, or maximum recursion limit has been
+      // reached, exit the loop with the condition as the result.
+      --vm_stack_count;
+      if (nilp(condition) || recurse_count.value.integer >= while_recurse_limit.value) {
+        TOP = condition;
+        FRAME.pc = target;
+      } else {
+        TOP = recurse_count;
+      }
+      break;
+    }
+    case OP_LAMBDA: {
+      Atom lambda = chunk->constants[code[FRAME.pc++]];
+      Atom closure = nil;
+      err = make_closure(FRAME.environment, car(lambda), cdr(lambda), &closure);
+      if (err.type) { goto fail; }
+      PUSH(closure);
+      break;
+    }
+    case OP_OPERATOR: {
+      Instruction site = code[FRAME.pc++];
+      Atom operator = nil;
+      err = env_get_cached(FRAME.environment, car(chunk->sites[site].form),
+                           &chunk->sites[site].cache, &operator);
+      if (err.type) { goto fail; }
+      if (macrop(operator)) {
+        FRAME.pc = chunk->sites[site].skip;
+        err = vm_expand(chunk, site, operator);
+        if (err.type) { goto fail; }
+        break;
+      }
+      PUSH(operator);
+      break;
+    }
+    case OP_CHECK_OPERATOR: {
+      Instruction site = code[FRAME.pc++];
+      if (macrop(TOP)) {
+        Atom macro = POP();
+        FRAME.pc = chunk->sites[site].skip;
+        err = vm_expand(chunk, site, macro);
+        if (err.type) { goto fail; }
+      }
+      break;
+    }
+    case OP_EXPAND: {
+      Instruction site = code[FRAME.pc++];
+      Atom operator = nil;
+      err = env_get_cached(FRAME.environment, car(chunk->sites[site].form),
+                           &chunk->sites[site].cache, &operator);
+      if (err.type) { goto fail; }
+      if (macrop(operator)) {
+        err = vm_expand(chunk, site, operator);
+        if (err.type) { goto fail; }
+        break;
+      }
+      // No longer a macro (redefined or shadowed); interpret it.
+      Atom value = nil;
+      err = evaluate_expression(chunk->sites[site].form, FRAME.environment, &value);
+      if (err.type) { goto fail; }
+      PUSH(value);
+      break;
+    }
+    case OP_CALL:
+    case OP_TAIL_CALL: {
+      char tail = code[FRAME.pc - 1] == OP_TAIL_CALL;
+      size_t argument_count = code[FRAME.pc++];
+      err = vm_call(argument_count, FRAME.environment, tail);
+      if (err.type) { goto fail; }
+      if (vm_safepoint()) { goto quit; }
+      break;
+    }
+    case OP_RETURN: {
+      Atom value = TOP;
+      vm_stack_count = FRAME.base;
+      --vm_frames_count;
+      if (vm_frames_count == frames_base) {
+        *result = value;
+        return ok;
+      }
+      PUSH(value);
+      break;
+    }
+    case OP_ENV:
+      PUSH(FRAME.environment);
+      break;
+    case OP_EVALUATE: {
+      Atom value = nil;
+      err = evaluate_expression(TOP, FRAME.environment, &value);
+      if (err.type) { goto fail; }
+      TOP = value;
+      break;
+    }
+    case OP_ERROR: {
+      Atom message = chunk->constants[code[FRAME.pc++]];
+      fprintf(stderr, "LISP ERROR: %s\n", message.value.symbol);
+      *result = make_string(message.value.symbol);
+      if (aborted) { *aborted = 1; }
+      vm_frames_count = frames_base;
+      vm_stack_count = stack_base;
+      return ok;
+    }
+    case OP_INTERPRET: {
+      Atom value = nil;
+      err = evaluate_expression(chunk->constants[code[FRAME.pc++]], FRAME.environment, &value);
+      if (err.type) { goto fail; }
+      PUSH(value);
+      break;
+    }
+    default:
+      assert(0 && "Invalid bytecode instruction.");
+      break;
+    }
+  }
+  return ok;
+
+ quit:
+  *result = nil;
+  vm_frames_count = frames_base;
+  vm_stack_count = stack_base;
+  return ok;
+
+ fail:
+  vm_frames_count = frames_base;
+  vm_stack_count = stack_base;
+  return err;
+}
+
+Error bytecode_apply(Atom closure, Atom arguments, Atom *result, char *aborted) {
+  if (aborted) { *aborted = 0; }
+  if (!closurep(closure)) {
+    MAKE_ERROR(err, ERROR_TYPE
+               , closure
+               , "APPLY: Expected operator type of #<BUILTIN> or #<CLOSURE>."
+               , NULL);
+    return err;
+  }
+  size_t frames_base = vm_frames_count;
+  size_t stack_base = vm_stack_count;
+  size_t argument_count = form_length(arguments);
+  vm_reserve(argument_count + 1);
+  PUSH(closure);
+  for (; pairp(arguments); arguments = cdr(arguments)) {
+    PUSH(car(arguments));
+  }
+  Error err = vm_call(argument_count, nil, 0);
+  if (err.type) {
+    vm_stack_count = stack_base;
+    return err;
+  }
+  return vm_run(frames_base, stack_base, result, aborted);
+}
+
+//================================================================ END virtual_machine
+
+static void bytecode_mark_chunk(Bytecode *chunk) {
+  if (!chunk || chunk->mark) { return; }
+  chunk->mark = 1;
+  gcol_mark(&chunk->parameters);
+  gcol_mark(&chunk->body);
+  gcol_mark(&chunk->scopes);
+  for (size_t i = 0; i < chunk->constants_count; ++i) {
+    gcol_mark(chunk->constants + i);
+  }
+  for (size_t i = 0; i < chunk->sites_count; ++i) {
+    gcol_mark(&chunk->sites[i].form);
+    gcol_mark(&chunk->sites[i].macro);
+    bytecode_mark_chunk(chunk->sites[i].expansion);
+  }
+}
+
+/// Return non-zero iff what closure bytecode was compiled from is still
+/// in use: it's body, and the parameter lists it was resolved against.
+static int bytecode_compiled_from_marked(Bytecode *chunk) {
+  if (!gcol_marked(chunk->body)) { return 0; }
+  for (Atom scope = chunk->scopes; pairp(scope); scope = cdr(scope)) {
+    if (pairp(car(scope)) && !gcol_marked(car(scope))) { return 0; }
+  }
+  return 1;
+}
+
+void bytecode_mark(void) {
+  for (size_t i = 0; i < vm_stack_count; ++i) {
+    gcol_mark(vm_stack + i);
+  }
+  for (size_t i = 0; i < vm_frames_count; ++i) {
+    gcol_mark(&vm_frames[i].environment);
+    bytecode_mark_chunk(vm_frames[i].chunk);
+  }
+  // Bytecode of a closure is only kept as long as the body and scopes
+  // it was compiled from are; marking it may keep others alive in turn.
+  char changed;
+  do {
+    changed = 0;
+    for (size_t i = 0; i < bytecode_table_capacity; ++i) {
+      for (Bytecode *chunk = bytecode_table[i]; chunk; chunk = chunk->same_body) {
+        if (!chunk->mark && bytecode_compiled_from_marked(chunk)) {
+          bytecode_mark_chunk(chunk);
+          changed = 1;
+        }
+      }
+    }
+  } while (changed);
+}
+
+void bytecode_sweep(void) {
+  Bytecode **it = &bytecode_allocations;
+  Bytecode *chunk;
+  while ((chunk = *it)) {
+    if (!chunk->mark) {
+      *it = chunk->next;
+      bytecode_free(chunk);
+      continue;
+    }
+    it = &chunk->next;
+  }
+  // Rebuild the table out of what survived.
+  if (bytecode_table) {
+    memset(bytecode_table, 0, bytecode_table_capacity * sizeof(Bytecode *));
+  }
+  bytecode_table_count = 0;
+  for (chunk = bytecode_allocations; chunk; chunk = chunk->next) {
+    chunk->mark = 0;
+    if (chunk->closure && pairp(chunk->body)) {
+      Bytecode **slot = bytecode_table_slot(chunk->body.value.pair);
+      if (!*slot) { bytecode_table_count += 1; }
+      chunk->same_body = *slot;
+      *slot = chunk;
+    }
+  }
+}
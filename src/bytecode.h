@@ -0,0 +1,56 @@
+#ifndef LITE_BYTECODE_H
+#define LITE_BYTECODE_H
+
+#include <error.h>
+#include <types.h>
+
+/* Closures are compiled into bytecode the first time they are called,
+ * and then run on a small stack-based virtual machine instead of the
+ * frame stack of the tree-walking evaluator.
+ *
+ * Compiled bytecode is cached by the body of the closure, so every
+ * closure created by evaluating the same LAMBDA form within the same
+ * closures shares it; the form is compiled again for each other set of
+ * closures it's evaluated within. Macro applications within a body
+ * are expanded the first time they are reached, and the expansion is
+ * compiled in place.
+ *
+ * References to parameters of the closure being compiled, or of any
+ * closure it is lexically within, are resolved when compiling to the
+ * environment they are bound in. At run-time, only the environments of
+ * the closures in between are searched before it, in case the name was
+ * bound directly into one of them (i.e. with ENV-SET-DIRECT).
+ *
+ * The tree-walking evaluator is still used for top-level expressions,
+ * for EVALUATE, for the bodies of macros, and for anything the
+ * compiler doesn't understand the shape of (malformed special forms
+ * are left for it to report the error of, just as they always have).
+ */
+
+/** Call CLOSURE with the already-evaluated ARGUMENTS, compiling it into
+ *  bytecode if it hasn't been already.
+ *
+ * @param closure A closure atom.
+ * @param arguments A list of argument values to bind to the
+ *                  parameters of CLOSURE.
+ * @param result Where the return value of CLOSURE is written.
+ * @param aborted If non-NULL, set to non-zero when evaluation was
+ *                stopped by the ERROR special form, and zero otherwise.
+ */
+Error bytecode_apply(Atom closure, Atom arguments, Atom *result, char *aborted);
+
+/** Mark everything the bytecode compiler and virtual machine are
+ *  holding on to as in-use.
+ *
+ * Must be called after every other root has been marked, as compiled
+ * bytecode is only kept alive for bodies that are otherwise reachable.
+ */
+void bytecode_mark(void);
+
+/** Free all compiled bytecode that wasn't marked by bytecode_mark().
+ *
+ * Must be called after marking, but before the pairs are swept.
+ */
+void bytecode_sweep(void);
+
+#endif /* LITE_BYTECODE_H */
@@ -2,6 +2,7 @@
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef LITE_GFX
 #  include <api.h>
@@ -10,39 +11,57 @@
 
 #include <builtins.h>
 #include <error.h>
+#include <evaluation.h>
 #include <types.h>
+#include <utility.h>
 
 char user_quit = 0;
 
-Atom env_create_nofree(Atom parent, size_t initial_capacity) {
-  Environment *env = calloc(1, sizeof *env);
+static Atom global_environment = { ATOM_TYPE_NIL, { 0 } };
+
+/// Bumped whenever every EnvironmentCache must be invalidated. Starts
+/// at one so that a zeroed cache is never valid.
+static size_t cache_version = 1;
+
+/// Every registered WatchedVariable, most recently registered first.
+static WatchedVariable *watched_variables = NULL;
+
+/// The hash table of an environment starts out directly after it, in
+/// the same allocation.
+#define env_inline_data(env) ((EnvironmentValue *)((env) + 1))
+
+static void env_finalize(void *env) {
+  EnvironmentValue *data = ((Environment *)env)->data;
+  if (data != env_inline_data((Environment *)env)) {
+    free(data);
+  }
+}
+
+Atom env_create(Atom parent, size_t initial_capacity) {
+  Atom out = nil;
+  out.type = ATOM_TYPE_ENVIRONMENT;
+  // The hash table is freed along with the environment, whatever it
+  // has been expanded into since.
+  Environment *env = gcol_allocate(sizeof *env + initial_capacity * sizeof *env->data, env_finalize);
   if (!env) {
     fprintf(stderr, "env_create() could not allocate new environment.");
     exit(9);
   }
   env->parent = parent;
+  env->parameters = nil;
+  // Parents never change, so neither does this.
+  env->global_descendant = envp(parent) && parent.value.env->global_descendant;
   env->data_count = 0;
   env->data_capacity = initial_capacity;
-  env->data = calloc(1, initial_capacity * sizeof *env->data);
-  if (!env->data) {
-    fprintf(stderr, "env_create() could not allocate new hash table.");
-    exit(9);
-  }
-
-  Atom out;
-  out.type = ATOM_TYPE_ENVIRONMENT;
-  out.galloc = 0;
-  out.docstring = NULL;
+  env->data = env_inline_data(env);
+  memset(env->data, 0, initial_capacity * sizeof *env->data);
   out.value.env = env;
-
   return out;
 }
 
-Atom env_create(Atom parent, size_t initial_capacity) {
-  Atom out = env_create_nofree(parent, initial_capacity);
-  gcol_generic_allocation(&out, out.value.env);
-  gcol_generic_allocation(&out, out.value.env->data);
-  out.value.env->galloc_data = out.galloc;
+Atom env_create_call(Atom parent, Atom parameters) {
+  Atom out = env_create(parent, ENV_SMALL_CAPACITY);
+  out.value.env->parameters = parameters;
   return out;
 }
 
@@ -70,62 +89,103 @@ static size_t env_hash(Environment table, char *symbol_pointer) {
   return hash & (table.data_capacity - 1);
 }
 
-static void env_expand(Environment *table);
-
-/// Return the entry for the given key string.
-// TODO: I haven't tested this myself, as I'm not *that* proficient at
-// writing hash tables, but there are (apparently) better ways to do
-// collision avoidance and such.
-// https://www.sebastiansylvan.com/post/robin-hood-hashing-should-be-your-default-hash-table-implementation/
+/* Environment tables are open addressed, with Robin Hood hashing:
+ * every entry keeps how far it is from where it's key hashes to, and
+ * an entry being inserted takes the place of any it comes across that
+ * is closer to home than it is, which then carries on in it's stead.
+ * Every key is then about as close to home as any other, and a lookup
+ * can stop at the first entry closer to home than the key would be.
+ * Removing an entry shifts those after it back, rather than leaving a
+ * tombstone.
+ *
+ * Environments with room for no more than ENV_SMALL_CAPACITY bindings,
+ * which is most every environment a closure is called in, don't hash
+ * at all: they're a vector of entries in the order they were bound,
+ * scanned from the start, as that is quicker than hashing for so few.
+ * One is made into a hash table once it outgrows that.
+ *
+ * Entries move about on insertion and removal, so bindings of the
+ * global environment that are cached are invalidated whenever any do.
+ */
+
+/// Return non-zero iff ENV is a vector rather than a hash table.
+#define env_small(env) ((env)->data_capacity <= ENV_SMALL_CAPACITY)
+/// Hash tables are grown once more than three quarters full.
+#define env_over_load(count, capacity) ((count) * 4 > (capacity) * 3)
+
+/// Return the entry that binds SYMBOL_POINTER in ENV, or NULL if none.
+HOTFUNCTION
 static EnvironmentValue *env_entry(Environment *env, char *symbol_pointer) {
-  if (!symbol_pointer) {
-    fprintf(stderr, "Can not get environment entry for NULL key!\n");
+  if (!env->data_count) {
     return NULL;
   }
+  if (env_small(env)) {
+    EnvironmentValue *end = env->data + env->data_count;
+    for (EnvironmentValue *entry = env->data; entry < end; ++entry) {
+      if (entry->key == symbol_pointer) {
+        return entry;
+      }
+    }
+    return NULL;
+  }
+  size_t mask = env->data_capacity - 1;
   size_t index = env_hash(*env, symbol_pointer);
-  EnvironmentValue *entry;
-
-  size_t index_it = index;
-  while (index_it < env->data_capacity) {
-    entry = env->data + index_it;
+  for (size_t distance = 0;; ++distance) {
+    EnvironmentValue *entry = env->data + index;
     if (entry->key == symbol_pointer) {
       return entry;
     }
-    if (entry->key == NULL) {
-      return entry;
+    if (!entry->key || entry->distance < distance) {
+      return NULL;
     }
-    ++index_it;
+    index = (index + 1) & mask;
   }
+}
 
-  index_it = 0;
-  while (index_it < index) {
-    entry = env->data + index_it;
-    if (entry->key == symbol_pointer) {
-      return entry;
+/// Put a new binding of SYMBOL_POINTER to VALUE in ENV, which must have
+/// room for it. Return non-zero iff any other entry was moved.
+static int env_place(Environment *env, char *symbol_pointer, Atom value) {
+  if (env_small(env)) {
+    EnvironmentValue *entry = env->data + env->data_count;
+    entry->key = symbol_pointer;
+    entry->distance = 0;
+    entry->value = value;
+    return 0;
+  }
+  size_t mask = env->data_capacity - 1;
+  size_t index = env_hash(*env, symbol_pointer);
+  EnvironmentValue carried;
+  carried.key = symbol_pointer;
+  carried.distance = 0;
+  carried.value = value;
+  int moved = 0;
+  for (;;) {
+    EnvironmentValue *entry = env->data + index;
+    if (!entry->key) {
+      *entry = carried;
+      return moved;
     }
-    if (entry->key == NULL) {
-      return entry;
+    if (entry->distance < carried.distance) {
+      EnvironmentValue displaced = *entry;
+      *entry = carried;
+      carried = displaced;
+      moved = 1;
     }
-    ++index_it;
+    index = (index + 1) & mask;
+    carried.distance += 1;
   }
-
-  // Expand and try again.
-  // FIXME: It's probably best to expand BEFORE the hash table is
-  // completely full...
-  env_expand(env);
-  return env_entry(env, symbol_pointer);
-}
-
-static void env_insert(Environment *env, char *symbol_pointer, Atom to_insert) {
-  EnvironmentValue *entry = env_entry(env, symbol_pointer);
-  entry->key = symbol_pointer;
-  entry->value = to_insert;
 }
 
 static void env_expand(Environment *table) {
-  // Create a new, larger hash table.
+  // Create a new, larger hash table; a vector grows to full size, and
+  // then into a hash table.
   size_t old_capacity = table->data_capacity;
-  size_t new_capacity = table->data_capacity << 1;
+  size_t new_capacity = old_capacity << 1;
+  if (old_capacity < ENV_SMALL_CAPACITY) {
+    new_capacity = ENV_SMALL_CAPACITY;
+  } else if (old_capacity == ENV_SMALL_CAPACITY) {
+    new_capacity = ENV_SMALL_CAPACITY << 1;
+  }
   EnvironmentValue *new_data = calloc(1, new_capacity * sizeof(*new_data));
   if (!new_data) {
     fprintf(stderr, "env_expand() could not allocate new hash table.");
@@ -133,48 +193,146 @@ static void env_expand(Environment *table) {
   }
 
   EnvironmentValue *old_data = table->data;
+  if (table == global_environment.value.env) {
+    // Caches point into the old data.
+    ++cache_version;
+  }
   table->data = new_data;
   table->data_capacity = new_capacity;
-  if (table->galloc_data) {
-    table->galloc_data->payload = new_data;
-  }
 
-  // Rehash all values from old table into new table. This is needed
-  // because the index where the symbol is stored is a function of the
-  // capacity of the table: when the capacity changes, so does the
-  // mapping of hashes to indices. There aren't really many ways to
-  // avoid this. One would be to not actually get rid of the old table,
-  // and have it implemented as a linked list of tables, but this very
-  // quickly slows down lookup and insertion by quite a bit. This
-  // rehashing method, while expensive, only occurs during expansion,
-  // which very rarely occurs in the first place.
+  // Rehash all values from old table into new table, as the index
+  // where a symbol is stored is a function of the capacity.
+  table->data_count = 0;
   EnvironmentValue *entry = old_data;
-  // For every value bound in old table, insert binding into new table.
   for (size_t i = 0; i < old_capacity; ++i, ++entry) {
     if (entry->key) {
-      env_insert(table, entry->key, entry->value);
+      env_place(table, entry->key, entry->value);
+      table->data_count += 1;
     }
   }
 
-  free(old_data);
+  if (old_data != env_inline_data(table)) {
+    free(old_data);
+  }
+}
 
-  // Debug output.
-  size_t old_size = old_capacity * sizeof(*table->data);
-  size_t new_size = old_size << 1;
-  if (!strict_output) {
-    printf("Environment size expanded from %zu to %zu entries (%zu to %zu bytes)\n",
-           old_capacity, new_capacity, old_size, new_size);
+static void env_insert(Environment *env, char *symbol_pointer, Atom to_insert) {
+  EnvironmentValue *entry = env_entry(env, symbol_pointer);
+  if (entry) {
+    entry->value = to_insert;
+    return;
+  }
+  if (env_small(env)
+      ? env->data_count == env->data_capacity
+      : env_over_load(env->data_count + 1, env->data_capacity))
+    {
+      env_expand(env);
+    }
+  if (env_place(env, symbol_pointer, to_insert) && env == global_environment.value.env) {
+    ++cache_version;
+  }
+  env->data_count += 1;
+}
+
+/// Remove the binding of SYMBOL_POINTER from ENV. Return non-zero iff
+/// there was one.
+static int env_erase(Environment *env, char *symbol_pointer) {
+  EnvironmentValue *entry = env_entry(env, symbol_pointer);
+  if (!entry) {
+    return 0;
+  }
+  if (env_small(env)) {
+    // Fill the gap with the last entry.
+    EnvironmentValue *last = env->data + env->data_count - 1;
+    *entry = *last;
+    memset(last, 0, sizeof *last);
+  } else {
+    size_t mask = env->data_capacity - 1;
+    size_t index = (size_t)(entry - env->data);
+    size_t next = (index + 1) & mask;
+    while (env->data[next].key && env->data[next].distance) {
+      env->data[index] = env->data[next];
+      env->data[index].distance -= 1;
+      index = next;
+      next = (next + 1) & mask;
+    }
+    memset(env->data + index, 0, sizeof *env->data);
+  }
+  env->data_count -= 1;
+  if (env == global_environment.value.env) {
+    ++cache_version;
+  }
+  return 1;
+}
+
+static void env_watched_update(WatchedVariable *variable, Atom value) {
+  switch (variable->type) {
+  case WATCHED_INTEGER:
+    variable->value = integerp(value) ? value.value.integer : variable->fallback;
+    break;
+  case WATCHED_NON_NIL:
+    variable->value = !nilp(value);
+    break;
+  }
+}
+
+void env_watch(WatchedVariable *variable) {
+  if (nilp(variable->symbol)) {
+    variable->symbol = make_sym((char *)variable->name);
+    *symbol_flags(variable->symbol) |= SYMBOL_FLAG_WATCHED;
+    variable->next = watched_variables;
+    watched_variables = variable;
+  }
+  // Catch up with the binding it may already have.
+  if (envp(global_environment)) {
+    EnvironmentValue *binding = env_binding(global_environment, variable->symbol);
+    env_watched_update(variable, binding ? binding->value : nil);
   }
 }
 
 Error env_set(Atom environment, Atom symbol, Atom value) {
+  if (environment.value.env == global_environment.value.env) {
+    if (*symbol_flags(symbol) & SYMBOL_FLAG_WATCHED) {
+      for (WatchedVariable *it = watched_variables; it; it = it->next) {
+        if (it->symbol.value.symbol == symbol.value.symbol) {
+          env_watched_update(it, value);
+        }
+      }
+    }
+  } else if (!nilp(environment.value.env->parent)) {
+    unsigned char *flags = symbol_flags(symbol);
+    // This binding may shadow a global one that's been cached, so no
+    // cache of this symbol is used from now on.
+    *flags |= SYMBOL_FLAG_LOCALLY_BOUND;
+  }
   env_insert(environment.value.env, symbol.value.symbol, value);
+  gcol_write_barrier(environment, value);
   //printf("Set %s to ", symbol.value.symbol);
   //print_atom(value);
   //putchar('\n');
   return ok;
 }
 
+EnvironmentValue *env_binding(Atom environment, Atom symbol) {
+  return env_entry(environment.value.env, symbol.value.symbol);
+}
+
+int env_remove(Atom environment, Atom symbol) {
+  if (!env_erase(environment.value.env, symbol.value.symbol)) {
+    return 0;
+  }
+  if (environment.value.env == global_environment.value.env
+      && *symbol_flags(symbol) & SYMBOL_FLAG_WATCHED)
+    {
+      for (WatchedVariable *it = watched_variables; it; it = it->next) {
+        if (it->symbol.value.symbol == symbol.value.symbol) {
+          env_watched_update(it, nil);
+        }
+      }
+    }
+  return 1;
+}
+
 void env_free(Environment env) {
   free(env.data);
 }
@@ -183,16 +341,16 @@ Atom env_get_containing(Atom environment, Atom symbol) {
 # ifdef LITE_GFX
   // Handle reading/popup-buffer.
   if (gui_ctx() && gui_ctx()->reading
-      && symbol.value.symbol == make_sym("CURRENT-BUFFER").value.symbol
+      && symbol.value.symbol == SYM(CURRENT_BUFFER).value.symbol
       ) {
-    symbol = make_sym("POPUP-BUFFER");
+    symbol = SYM(POPUP_BUFFER);
   }
 # endif /* #ifdef LITE_GFX */
 
   EnvironmentValue *entry = env_entry(environment.value.env, symbol.value.symbol);
 
-  // No key means not bound.
-  if (!entry->key) {
+  // No entry means not bound.
+  if (!entry) {
     // Attempt to check parent environment, if it exists.
     if (!nilp(environment.value.env->parent)) {
       return env_get_containing(environment.value.env->parent, symbol);
@@ -208,16 +366,16 @@ Error env_get(Atom environment, Atom symbol, Atom *result) {
 # ifdef LITE_GFX
   // Handle reading/popup-buffer.
   if (gui_ctx() && gui_ctx()->reading
-      && symbol.value.symbol == make_sym("CURRENT-BUFFER").value.symbol
+      && symbol.value.symbol == SYM(CURRENT_BUFFER).value.symbol
       ) {
-    symbol = make_sym("POPUP-BUFFER");
+    symbol = SYM(POPUP_BUFFER);
   }
 # endif /* #ifdef LITE_GFX */
 
   EnvironmentValue *entry = env_entry(environment.value.env, symbol.value.symbol);
 
-  // No key means not bound.
-  if (!entry->key) {
+  // No entry means not bound.
+  if (!entry) {
     // If there is a parent environment, search that.
     if (!nilp(environment.value.env->parent)) {
       return env_get(environment.value.env->parent, symbol, result);
@@ -238,6 +396,43 @@ Error env_get(Atom environment, Atom symbol, Atom *result) {
   return ok;
 }
 
+HOTFUNCTION
+Error env_get_cached(Atom environment, Atom symbol, EnvironmentCache *cache, Atom *result) {
+# ifdef LITE_GFX
+  // Reading redirects CURRENT-BUFFER, which a cache would not.
+  if (gui_ctx() && gui_ctx()->reading) {
+    return env_get(environment, symbol, result);
+  }
+# endif /* #ifdef LITE_GFX */
+  if (cache->version == cache_version
+      && environment.value.env->global_descendant
+      && !(*symbol_flags(symbol) & SYMBOL_FLAG_LOCALLY_BOUND))
+    {
+      *result = cache->binding->value;
+      return ok;
+    }
+  Error err = env_get(environment, symbol, result);
+  if (err.type) { return err; }
+  if (!(*symbol_flags(symbol) & SYMBOL_FLAG_LOCALLY_BOUND)
+      && environment.value.env->global_descendant)
+    {
+      // Never bound locally, so it must've been found globally.
+      EnvironmentValue *binding = env_binding(global_environment, symbol);
+      if (binding) {
+        cache->binding = binding;
+        cache->version = cache_version;
+      }
+    }
+  return ok;
+}
+
+Error env_get_global(GlobalVariable *variable, Atom *result) {
+  if (nilp(variable->symbol)) {
+    variable->symbol = make_sym((char *)variable->name);
+  }
+  return env_get_cached(*genv(), variable->symbol, &variable->cache, result);
+}
+
 int env_non_nil(Atom environment, Atom symbol) {
   Atom bind = nil;
   Error err = env_get(environment, symbol, &bind);
@@ -251,9 +446,7 @@ int boundp(Atom environment, Atom symbol) {
   if (!envp(environment) || !symbolp(symbol)) {
     return 0;
   }
-  EnvironmentValue *entry = env_entry(environment.value.env, symbol.value.symbol);
-  // Key must not be NULL for a binding to be valid.
-  return entry->key != NULL;
+  return env_entry(environment.value.env, symbol.value.symbol) != NULL;
 }
 
 #define defbuiltin(name) do {                                   \
@@ -263,55 +456,68 @@ int boundp(Atom environment, Atom symbol) {
                        (char *)builtin_##name##_docstring));    \
   } while (0)
 
+/// Also register the vector calling convention of builtin NAME.
+#define defvector(name) do {                                    \
+    defbuiltin(name);                                           \
+    builtin_vector_register(&builtin_##name##_vector);          \
+  } while (0)
+
+/// Bind the symbol NAME to VALUE in ENVIRONMENT, documented by DOCSTRING.
+static void env_set_with_docstring(Atom environment, Atom name, Atom value, char *docstring) {
+  env_set(environment, name, value);
+  symbol_set_docstring(name, docstring);
+}
+
 #ifndef LITE_DEFAULT_ENVIRONMENT_INITIAL_CAPACITY
 # define LITE_DEFAULT_ENVIRONMENT_INITIAL_CAPACITY 2 << 8
 #endif /* LITE_DEFAULT_ENVIRONMENT_INITIAL_CAPACITY */
 Atom default_environment(void) {
+  symbols_initialize();
   Atom environment = env_create(nil, LITE_DEFAULT_ENVIRONMENT_INITIAL_CAPACITY);
-  env_set(environment, make_sym("T"), make_sym("T"));
+  env_set(environment, SYM(T), SYM(T));
 
   defbuiltin(quit_lisp);
   defbuiltin(docstring);
   defbuiltin(tree_sitter_update);
 
-  defbuiltin(car);
-  defbuiltin(cdr);
-  defbuiltin(cons);
-  defbuiltin(setcar);
-  defbuiltin(setcdr);
-
-  defbuiltin(nilp);
-  defbuiltin(pairp);
-  defbuiltin(symbolp);
-  defbuiltin(integerp);
-  defbuiltin(builtinp);
-  defbuiltin(closurep);
-  defbuiltin(macrop);
-  defbuiltin(stringp);
-  defbuiltin(bufferp);
-  defbuiltin(envp);
-
-  defbuiltin(add);
-  defbuiltin(subtract);
-  defbuiltin(multiply);
-  defbuiltin(divide);
-  defbuiltin(remainder);
-
-  defbuiltin(bitand);
-  defbuiltin(bitor);
-  defbuiltin(bitxor);
-  defbuiltin(bitnot);
-  defbuiltin(bitshl);
-  defbuiltin(bitshr);
-
-  defbuiltin(not);
-  defbuiltin(eq);
-  defbuiltin(numeq);
-  defbuiltin(numnoteq);
-  defbuiltin(numlt);
-  defbuiltin(numlt_or_eq);
-  defbuiltin(numgt);
-  defbuiltin(numgt_or_eq);
+  defvector(car);
+  defvector(cdr);
+  defvector(cons);
+  defvector(setcar);
+  defvector(setcdr);
+
+  defvector(nilp);
+  defvector(pairp);
+  defvector(symbolp);
+  defvector(integerp);
+  defvector(builtinp);
+  defvector(closurep);
+  defvector(macrop);
+  defvector(stringp);
+  defvector(bufferp);
+  defvector(envp);
+
+  defvector(add);
+  defvector(subtract);
+  defvector(multiply);
+  defvector(divide);
+  defvector(remainder);
+
+  defvector(bitand);
+  defvector(bitor);
+  defvector(bitxor);
+  defvector(bitnot);
+  defvector(bitshl);
+  defvector(bitshr);
+
+  defvector(not);
+  defvector(eq);
+  defvector(numeq);
+  defvector(numnoteq);
+  defvector(numlt);
+  defvector(numlt_or_eq);
+  defvector(numgt);
+  defvector(numgt_or_eq);
 
   defbuiltin(copy);
   defbuiltin(function_body);
@@ -322,9 +528,11 @@ Atom default_environment(void) {
   defbuiltin(prins);
 
   defbuiltin(symbol_table);
+  defbuiltin(garbage_collector_statistics);
 
   defbuiltin(env_set);
   defbuiltin(env_set_direct);
+  defbuiltin(env_remove_direct);
   defbuiltin(env_get);
   defbuiltin(env_get_direct);
   defbuiltin(env_parent);
@@ -338,21 +546,22 @@ Atom default_environment(void) {
   defbuiltin(buffer_region);
   defbuiltin(buffer_region_length);
   defbuiltin(buffer_table);
+  defvector(close_buffer);
   defbuiltin(buffer_path);
   defbuiltin(open_buffer);
-  defbuiltin(buffer_insert);
-  defbuiltin(buffer_remove);
-  defbuiltin(buffer_remove_forward);
-  defbuiltin(buffer_undo);
-  defbuiltin(buffer_redo);
-  defbuiltin(buffer_string);
-  defbuiltin(buffer_lines);
-  defbuiltin(buffer_line);
-  defbuiltin(buffer_current_line);
-  defbuiltin(buffer_set_point);
-  defbuiltin(buffer_point);
+  defvector(buffer_insert);
+  defvector(buffer_remove);
+  defvector(buffer_remove_forward);
+  defvector(buffer_undo);
+  defvector(buffer_redo);
+  defvector(buffer_string);
+  defvector(buffer_lines);
+  defvector(buffer_line);
+  defvector(buffer_current_line);
+  defvector(buffer_set_point);
+  defvector(buffer_point);
   defbuiltin(buffer_row_col);
-  defbuiltin(buffer_index);
+  defvector(buffer_index);
   defbuiltin(buffer_seek_byte);
   defbuiltin(buffer_seek_past_byte);
   defbuiltin(buffer_seek_substring);
@@ -373,8 +582,8 @@ Atom default_environment(void) {
   defbuiltin(evaluate_string);
   defbuiltin(evaluate_file);
 
-  defbuiltin(member);
-  defbuiltin(length);
+  defvector(member);
+  defvector(length);
 
   defbuiltin(clipboard_cut);
   defbuiltin(clipboard_copy);
@@ -414,58 +623,73 @@ Atom default_environment(void) {
 #         endif
           );
 
-  env_set(environment, make_sym((char *)"WHILE-RECURSE-LIMIT"), make_int_with_docstring
-          (10000,
-           "This is the maximum amount of times a while loop may loop.\n"
-           "\n"
-           "Used to prevent infinite loops."));
+  env_set_with_docstring(environment, make_sym((char *)"WHILE-RECURSE-LIMIT"), make_int(10000),
+                         "This is the maximum amount of times a while loop may loop.\n"
+                         "\n"
+                         "Used to prevent infinite loops.");
 
-  env_set(environment, make_sym("GARBAGE-COLLECTOR-EVALUATION-ITERATIONS-THRESHOLD"),
-          make_int_with_docstring
-          (100000, "This number corresponds to the amount of evaluation operations before \
+  env_set_with_docstring(environment, make_sym("GARBAGE-COLLECTOR-EVALUATION-ITERATIONS-THRESHOLD"), make_int(100000),
+                         "This number corresponds to the amount of evaluation operations before \
 running the garbage collector.\nSmaller numbers mean memory is freed more often. \
-The default value of '100000' means memory is freed in around twenty megabyte chunks."));
+The default value of '100000' means memory is freed in around twenty megabyte chunks.");
 
-  env_set(environment, make_sym("GARBAGE-COLLECTOR-PAIR-ALLOCATIONS-THRESHOLD"),
-          make_int_with_docstring
-          ((integer_t)290500, "This number corresponds to the amount of pairs able to be allocated \
+  env_set_with_docstring(environment, make_sym("GARBAGE-COLLECTOR-PAIR-ALLOCATIONS-THRESHOLD"), make_int((integer_t)290500),
+                         "This number corresponds to the amount of pairs able to be allocated \
 before running the garbage collector.\nSmaller numbers mean memory is freed more often, \
-but too small causes problems."));
+but too small causes problems.");
+
+  env_set_with_docstring(environment, make_sym("GARBAGE-COLLECTOR-PAUSE-BUDGET"), make_int(2000),
+                         "This number corresponds to the amount of microseconds a major garbage \
+collection may pause evaluation for at a time.\nMajor collections are marked a little at \
+a time, in between evaluation and while waiting for input. Zero or less means they happen \
+all at once.");
+
+  env_set_with_docstring(environment, make_sym("GARBAGE-COLLECTOR-MARK-THREADS"), make_int(1),
+                         "This number corresponds to the amount of threads that mark what is in \
+use when finishing a garbage collection.\nThe default value of '1' means marking is done \
+on the thread evaluating, and no other threads are started. Builds without thread \
+support always mark on just the one.");
+
+  env_set_with_docstring(environment, make_sym("DEBUG/BYTECODE"), nil,
+                         "When non-nil, display the bytecode each closure body and macro \
+expansion is compiled into.");
 
-  env_set(environment, make_sym("DEBUG/ENVIRONMENT"), nil_with_docstring
-          ("When non-nil, display debug information concerning the current \
-LISP evaluation environment, including the symbol table."));
+  env_set_with_docstring(environment, make_sym("DEBUG/ENVIRONMENT"), nil,
+                         "When non-nil, display debug information concerning the current \
+LISP evaluation environment, including the symbol table.");
 
-  env_set(environment, make_sym("DEBUG/EVALUATE"), nil_with_docstring
-          ("When non-nil, display debug information concerning the evaluation of expressions."));
+  env_set_with_docstring(environment, make_sym("DEBUG/EVALUATE"), nil,
+                         "When non-nil, display debug information concerning the evaluation of expressions.");
 
-  env_set(environment, make_sym("DEBUG/KEYBINDING"), nil_with_docstring
-          ("When non-nil, display debug information concerning keybindings, \
-including information about keymaps on every button press."));
+  env_set_with_docstring(environment, SYM(DEBUG_KEYBINDING), nil,
+                         "When non-nil, display debug information concerning keybindings, \
+including information about keymaps on every button press.");
 
-  env_set(environment, make_sym("DEBUG/MACRO"), nil_with_docstring
-          ("When non-nil, display debug information concerning macros, \
-including what each expansion step looks like."));
+  env_set_with_docstring(environment, make_sym("DEBUG/MACRO"), nil,
+                         "When non-nil, display debug information concerning macros, \
+including what each expansion step looks like.");
 
-  env_set(environment, make_sym("DEBUG/MEMORY"), nil_with_docstring
-          ("When non-nil, display debug information concerning allocated memory, \
-including when garbage collections happen and data upon program exit."));
+  env_set_with_docstring(environment, SYM(DEBUG_MEMORY), nil,
+                         "When non-nil, display debug information concerning allocated memory, \
+including when garbage collections happen and data upon program exit.");
 
-  env_set(environment, make_sym("DEBUG/WHILE"), nil_with_docstring
-          ("When non-nil, display debug information concerning 'WHILE', \
-including data output at each iteration of the loop."));
+  env_set_with_docstring(environment, make_sym("DEBUG/WHILE"), nil,
+                         "When non-nil, display debug information concerning 'WHILE', \
+including data output at each iteration of the loop.");
 
   return environment;
 }
 
+#undef defvector
 #undef defbuiltin
 
 
-static Atom global_environment = { ATOM_TYPE_NIL, { 0 }, NULL, NULL };
 Atom *genv(void) {
   if (nilp(global_environment)) {
     //printf("Recreating global environment from defaults...\n");
     global_environment = default_environment();
+    global_environment.value.env->global_descendant = 1;
+    evaluation_watch_variables();
   }
   return &global_environment;
 }
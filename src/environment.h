@@ -4,17 +4,97 @@
 #include <types.h>
 #include <error.h>
 
-/// Create an environment without registering it in garbage collection
-/// system.
-Atom env_create_nofree(Atom parent, size_t initial_size);
+/// Environments with room for no more bindings than this are kept as a
+/// vector that is searched linearly, rather than as a hash table.
+#define ENV_SMALL_CAPACITY 8
+
 /// Create an environment and register it's allocated data in the
-/// garbage collection system.
+/// garbage collection system. INITIAL_SIZE must be no greater than
+/// ENV_SMALL_CAPACITY, or else a power of two.
 Atom env_create(Atom parent, size_t initial_size);
+/// Create an environment to bind the PARAMETERS of a closure or macro
+/// in when calling it, with the environment it closes over as PARENT.
+Atom env_create_call(Atom parent, Atom parameters);
 /// Bind SYMBOL to VALUE in ENVIRONMENT.
 Error env_set(Atom environment, Atom symbol, Atom value);
 /// Return VALUE bound to SYMBOL in ENVIRONMENT.
 Error env_get(Atom environment, Atom symbol, Atom *result);
 
+/// Return the entry binding SYMBOL within ENVIRONMENT itself, or NULL
+/// if there is none. Parent environments are not searched.
+EnvironmentValue *env_binding(Atom environment, Atom symbol);
+
+/// Remove the binding of SYMBOL within ENVIRONMENT itself. Parent
+/// environments are left alone. Return non-zero iff there was one.
+int env_remove(Atom environment, Atom symbol);
+
+/** Remembers where a symbol was found to be bound in the global
+ *  environment, so that it needn't be looked up again.
+ *
+ * A cache is only ever filled for a symbol that has never been bound
+ * in any environment besides the global one, so it is valid for any
+ * environment descending from the global environment until entries of
+ * the global environment are moved or removed, which invalidates every
+ * cache at once, or until the symbol is first bound locally, which
+ * invalidates just the caches of that symbol. Checking either is a
+ * load, not a search. Zero initialise.
+ */
+typedef struct EnvironmentCache {
+  size_t version;
+  EnvironmentValue *binding;
+} EnvironmentCache;
+
+/// Return VALUE bound to SYMBOL in ENVIRONMENT, just like env_get(),
+/// using and filling CACHE.
+Error env_get_cached(Atom environment, Atom symbol, EnvironmentCache *cache, Atom *result);
+
+/// A global variable that is referred to by name from C.
+/// Declare `static`, initialised with GLOBAL_VARIABLE(name).
+typedef struct GlobalVariable {
+  const char *name;
+  Atom symbol;
+  EnvironmentCache cache;
+} GlobalVariable;
+
+#define GLOBAL_VARIABLE(name) { (name), { ATOM_TYPE_NIL, { 0 } }, { 0, NULL } }
+
+/// Return the VALUE of VARIABLE in the global environment.
+Error env_get_global(GlobalVariable *variable, Atom *result);
+
+/** A C variable kept up to date with the value of a global variable.
+ *
+ * Whenever the symbol is bound in the global environment, by DEFINE,
+ * SET, ENV-SET, or env_set(), the C variable is updated, so it may be
+ * read directly wherever looking the symbol up would be too costly.
+ * Bindings in any other environment don't affect it.
+ *
+ * Declare `static`, initialised with WATCHED_INTEGER_VARIABLE() or
+ * WATCHED_NON_NIL_VARIABLE(), and register with env_watch(). VALUE
+ * holds the default until then.
+ */
+typedef struct WatchedVariable {
+  const char *name;
+  enum {
+    /// VALUE is the bound integer, or FALLBACK when bound to anything else.
+    WATCHED_INTEGER,
+    /// VALUE is non-zero iff bound to anything but nil.
+    WATCHED_NON_NIL,
+  } type;
+  integer_t fallback;
+  integer_t value;
+  Atom symbol;
+  struct WatchedVariable *next;
+} WatchedVariable;
+
+#define WATCHED_INTEGER_VARIABLE(name, fallback)                        \
+  { (name), WATCHED_INTEGER, (fallback), (fallback), { ATOM_TYPE_NIL, { 0 } }, NULL }
+#define WATCHED_NON_NIL_VARIABLE(name)                                  \
+  { (name), WATCHED_NON_NIL, 0, 0, { ATOM_TYPE_NIL, { 0 } }, NULL }
+
+/// Start keeping VARIABLE up to date with the global environment.
+/// Registering the same variable again only brings it up to date.
+void env_watch(WatchedVariable *variable);
+
 /// Get the containing environment where SYMBOL is bound, or nil if unbound.
 Atom env_get_containing(Atom environment, Atom symbol);
 
@@ -2,51 +2,279 @@
 
 #include <assert.h>
 #include <builtins.h>
+#include <bytecode.h>
 #include <ctype.h>
 #include <environment.h>
 #include <error.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <types.h>
 #include <utility.h>
 
-/* STACK-FRAME: (
- *   PARENT
- *   ENVIRONMENT
- *   EVALUATED-OPERATOR
- *   (PENDING-ARGUMENTS...)
- *   (EVALUATED-ARGUMENTS...)
- *   (BODY...)
- *   )
+WatchedVariable while_recurse_limit = WATCHED_INTEGER_VARIABLE("WHILE-RECURSE-LIMIT", 10000);
+
+#ifdef LITE_DBG
+static WatchedVariable debug_evaluate = WATCHED_NON_NIL_VARIABLE("DEBUG/EVALUATE");
+static WatchedVariable debug_macro    = WATCHED_NON_NIL_VARIABLE("DEBUG/MACRO");
+static WatchedVariable debug_while    = WATCHED_NON_NIL_VARIABLE("DEBUG/WHILE");
+static WatchedVariable debug_memory   = WATCHED_NON_NIL_VARIABLE("DEBUG/MEMORY");
+#endif
+
+static const char *const special_form_names[SPECIAL_FORM_COUNT] = {
+  [SPECIAL_FORM_NONE]            = NULL,
+  [SPECIAL_FORM_QUOTE]           = "QUOTE",
+  [SPECIAL_FORM_QUASIQUOTE]      = "QUASIQUOTE",
+  [SPECIAL_FORM_DEFINE]          = "DEFINE",
+  [SPECIAL_FORM_SET]             = "SET",
+  [SPECIAL_FORM_LAMBDA]          = "LAMBDA",
+  [SPECIAL_FORM_IF]              = "IF",
+  [SPECIAL_FORM_WHILE]           = "WHILE",
+  [SPECIAL_FORM_WHILE_BODY]      = "WHILE-BODY",
+  [SPECIAL_FORM_PROGN]           = "PROGN",
+  [SPECIAL_FORM_MACRO]           = "MACRO",
+  [SPECIAL_FORM_EVALUATE]        = "EVALUATE",
+  [SPECIAL_FORM_ENV]             = "ENV",
+  [SPECIAL_FORM_ERROR]           = "ERROR",
+  [SPECIAL_FORM_QUIT_COMPLETELY] = "QUIT-COMPLETELY",
+  [SPECIAL_FORM_OR]              = "OR",
+  [SPECIAL_FORM_AND]             = "AND",
+};
+
+/// Interned special form symbols, open-addressed by the address of
+/// their name. Kept sparse, so most symbols that aren't special forms
+/// land on an empty entry right away.
+#define SPECIAL_FORM_TABLE_CAPACITY 64
+static struct {
+  const char *symbol;
+  SpecialForm form;
+} special_form_table[SPECIAL_FORM_TABLE_CAPACITY];
+static char special_forms_interned = 0;
+
+static size_t special_form_hash(const char *symbol) {
+  // Symbol names are heap allocated, so the lowest bits vary the least.
+  return ((uintptr_t)symbol >> 4) & (SPECIAL_FORM_TABLE_CAPACITY - 1);
+}
+
+static void special_forms_intern(void) {
+  for (SpecialForm form = SPECIAL_FORM_NONE + 1; form < SPECIAL_FORM_COUNT; ++form) {
+    const char *symbol = make_sym((char *)special_form_names[form]).value.symbol;
+    size_t index = special_form_hash(symbol);
+    while (special_form_table[index].symbol) {
+      index = (index + 1) & (SPECIAL_FORM_TABLE_CAPACITY - 1);
+    }
+    special_form_table[index].symbol = symbol;
+    special_form_table[index].form = form;
+  }
+  special_forms_interned = 1;
+}
+
+HOTFUNCTION
+SpecialForm special_form(Atom atom) {
+  if (!symbolp(atom)) { return SPECIAL_FORM_NONE; }
+  if (!special_forms_interned) { special_forms_intern(); }
+  size_t index = special_form_hash(atom.value.symbol);
+  while (special_form_table[index].symbol) {
+    if (special_form_table[index].symbol == atom.value.symbol) {
+      return special_form_table[index].form;
+    }
+    index = (index + 1) & (SPECIAL_FORM_TABLE_CAPACITY - 1);
+  }
+  return SPECIAL_FORM_NONE;
+}
+
+/* The evaluator keeps a stack of frames, one for each expression that
+ * is waiting on the value of another. Each frame's parent is the frame
+ * directly beneath it.
+ *
+ * The stack is shared by every (nested) call to evaluate_expression(),
+ * each of which only ever touches the frames above where the stack was
+ * when it was called (it's base). As it may be reallocated whenever a
+ * frame is pushed, never hold on to a pointer into it across anything
+ * that may evaluate.
  */
+typedef struct EvaluationFrame {
+  Atom environment;
+  /// nil until the operator has been evaluated, a symbol for special forms.
+  Atom operator;
+  Atom pending_arguments;
+  /// In reverse order (last is first) until application.
+  Atom evaluated_arguments;
+  Atom body;
+  /// The entire form being applied, `(OPERATOR . ARGUMENTS)`, or nil.
+  Atom form;
+} EvaluationFrame;
+
+static EvaluationFrame *frames = NULL;
+static size_t frames_count = 0;
+static size_t frames_capacity = 0;
+
+/// The frame on top of the stack.
+#define FRAME (frames[frames_count - 1])
+
 HOTFUNCTION
-Atom make_frame(Atom parent, Atom environment, Atom tail) {
-  return cons(parent,
-              cons(environment,
-                   cons(nil,
-                        cons(tail,
-                             cons(nil,
-                                  cons(nil, nil))))));
-}
-
-void print_stackframe(Atom stack, int depth) {
-  if (nilp(stack)) { return; }
-  int d = depth;
-  while (--d >= 0) { putchar(' '); }
-  printf("operator: ");
-  print_atom(list_get(stack, 2));
-  printf(", pre-args: ");
-  print_atom(list_get(stack, 3));
-  printf(", args: ");
-  print_atom(list_get(stack, 4));
-  putchar('\n');
-  print_stackframe(car(stack), depth + 2);
-}
-
-/// Set EXPR to next expression in body of STACK.
-Error evaluate_next_expression(Atom *stack, Atom *expr, Atom *environment) {
-  *environment = list_get(*stack, 1);
-  Atom body = list_get(*stack, 5);
+static void push_frame(Atom environment, Atom pending_arguments) {
+  if (frames_count >= frames_capacity) {
+    size_t new_capacity = frames_capacity ? frames_capacity * 2 : 256;
+    EvaluationFrame *new_frames = realloc(frames, new_capacity * sizeof(EvaluationFrame));
+    if (!new_frames) {
+      fprintf(stderr, "EVALUATE: Could not allocate memory for stack frame.\n");
+      exit(1);
+    }
+    frames = new_frames;
+    frames_capacity = new_capacity;
+  }
+  EvaluationFrame *frame = frames + frames_count++;
+  frame->environment = environment;
+  frame->operator = nil;
+  frame->pending_arguments = pending_arguments;
+  frame->evaluated_arguments = nil;
+  frame->body = nil;
+  frame->form = nil;
+}
+
+/// Pop the top frame, carrying it's environment over to the frame
+/// beneath, unless that frame is below BASE.
+/// This is needed to allow for definitions in a body to affect outside of it.
+static void pop_frame_keep_environment(size_t base) {
+  --frames_count;
+  if (frames_count > base) {
+    FRAME.environment = frames[frames_count].environment;
+  }
+}
+
+static void print_stackframes(size_t base) {
+  int depth = 0;
+  for (size_t i = frames_count; i > base; --i, depth += 2) {
+    EvaluationFrame *frame = frames + i - 1;
+    int d = depth;
+    while (--d >= 0) { putchar(' '); }
+    printf("operator: ");
+    print_atom(frame->operator);
+    printf(", pre-args: ");
+    print_atom(frame->pending_arguments);
+    printf(", args: ");
+    print_atom(frame->evaluated_arguments);
+    putchar('\n');
+  }
+}
+
+/* Macro expansions are remembered by the form they were expanded
+ * from, so a form that is evaluated over and over (i.e. within a WHILE
+ * body) is only expanded the first time. Just like compiled bytecode,
+ * a form is expanded again whenever it's operator turns out to be a
+ * different macro than the one it was last expanded by.
+ */
+typedef struct MacroExpansion {
+  Atom form;
+  Atom macro;
+  Atom expansion;
+  char mark;
+} MacroExpansion;
+
+static MacroExpansion *macro_expansions = NULL;
+static size_t macro_expansions_count = 0;
+static size_t macro_expansions_capacity = 0;
+
+static size_t macro_expansion_hash(Pair *form) {
+  uint64_t key = (uint64_t)(uintptr_t)form;
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return (size_t)key;
+}
+
+static MacroExpansion *macro_expansion_slot(Pair *form) {
+  size_t mask = macro_expansions_capacity - 1;
+  size_t index = macro_expansion_hash(form) & mask;
+  while (!nilp(macro_expansions[index].form)
+         && macro_expansions[index].form.value.pair != form) {
+    index = (index + 1) & mask;
+  }
+  return macro_expansions + index;
+}
+
+/// Return the expansion of FORM by MACRO, or NULL if it hasn't been.
+static MacroExpansion *macro_expansion_get(Atom form, Atom macro) {
+  if (!macro_expansions || !pairp(form)) { return NULL; }
+  MacroExpansion *entry = macro_expansion_slot(form.value.pair);
+  if (nilp(entry->form) || entry->macro.value.pair != macro.value.pair) {
+    return NULL;
+  }
+  return entry;
+}
+
+static void macro_expansion_insert(Atom form, Atom macro, Atom expansion) {
+  if (!pairp(form)) { return; }
+  if ((macro_expansions_count + 1) * 2 > macro_expansions_capacity) {
+    MacroExpansion *old_table = macro_expansions;
+    size_t old_capacity = macro_expansions_capacity;
+    macro_expansions_capacity = old_capacity ? old_capacity * 2 : 64;
+    macro_expansions = calloc(macro_expansions_capacity, sizeof(MacroExpansion));
+    if (!macro_expansions) {
+      fprintf(stderr, "EVALUATE: Could not allocate memory for macro expansions.\n");
+      exit(1);
+    }
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (!nilp(old_table[i].form)) {
+        *macro_expansion_slot(old_table[i].form.value.pair) = old_table[i];
+      }
+    }
+    free(old_table);
+  }
+  MacroExpansion *entry = macro_expansion_slot(form.value.pair);
+  if (nilp(entry->form)) { macro_expansions_count += 1; }
+  entry->form = form;
+  entry->macro = macro;
+  entry->expansion = expansion;
+  entry->mark = 0;
+}
+
+/// Mark the expansions of forms that are otherwise in use.
+/// Must be called after every other root has been marked.
+static void macro_expansions_mark(void) {
+  // Marking an expansion may keep other forms alive in turn.
+  char changed;
+  do {
+    changed = 0;
+    for (size_t i = 0; i < macro_expansions_capacity; ++i) {
+      MacroExpansion *entry = macro_expansions + i;
+      if (!nilp(entry->form) && !entry->mark && gcol_marked(entry->form)) {
+        entry->mark = 1;
+        gcol_mark(&entry->macro);
+        gcol_mark(&entry->expansion);
+        changed = 1;
+      }
+    }
+  } while (changed);
+}
+
+/// Forget the expansions of forms that are about to be freed.
+static void macro_expansions_sweep(void) {
+  if (!macro_expansions) { return; }
+  MacroExpansion *old_table = macro_expansions;
+  macro_expansions = calloc(macro_expansions_capacity, sizeof(MacroExpansion));
+  if (!macro_expansions) {
+    fprintf(stderr, "EVALUATE: Could not allocate memory for macro expansions.\n");
+    exit(1);
+  }
+  macro_expansions_count = 0;
+  for (size_t i = 0; i < macro_expansions_capacity; ++i) {
+    MacroExpansion *entry = old_table + i;
+    if (entry->mark) {
+      entry->mark = 0;
+      *macro_expansion_slot(entry->form.value.pair) = *entry;
+      macro_expansions_count += 1;
+    }
+  }
+  free(old_table);
+}
+
+/// Set EXPR to next expression in body of the top frame.
+static Error evaluate_next_expression(Atom *expr, Atom *environment) {
+  *environment = FRAME.environment;
+  Atom body = FRAME.body;
   if (!pairp(body)) {
     MAKE_ERROR(err, ERROR_GENERIC, body,
                "Malformed stack body, can not continue evaluation.",
@@ -56,57 +284,25 @@ Error evaluate_next_expression(Atom *stack, Atom *expr, Atom *environment) {
   *expr = car(body);
   // Update body to have current expression removed.
   body = cdr(body);
-  list_set(*stack, 5, body);
-
-  // Body completely evaluated, attempt to finish evaluating parent stack.
-  // TODO: Is this correct? I feel like it's not, since we still have
-  // the last expression to evaluate before this stack frame is done,
-  // right? body being nil here is after it's updated, which means expr
-  // still needs evaluated, which means we're technically not done with
-  // the stack... right?
+  FRAME.body = body;
+
+  // The last expression of a body is in tail position; there is
+  // nothing left for this frame to do once it's evaluated, so the
+  // value goes straight to the parent.
   if (nilp(body)) {
-    *stack = car(*stack);
+    --frames_count;
   }
   return ok;
 }
 
-Error evaluate_bind_arguments(Atom *stack, Atom *expr, Atom *environment) {
-  Atom body = list_get(*stack, 5);
-  // If there is an existing body, then simply evaluate the next expression within it.
-  if (!nilp(body)) {
-    return evaluate_next_expression(stack, expr, environment);
-  }
-  // Else, bind the arguments into the current stack frame.
-
-  // Ensure operator is as expected (callable with arguments, not a builtin).
-  Atom operator = list_get(*stack, 2);
-  if (!closurep(operator) && !macrop(operator)) {
-    MAKE_ERROR(err, ERROR_GENERIC, operator,
-               "evaluate_bind_arguments() requires operator to be a closure or macro when body is nil.",
-               NULL);
-    return err;
-  }
-
-  // Extract expression body from operator.
-  body = cdr(cdr(operator));
-  list_set(*stack, 5, body);
-
-  // Create local environment for arguments, with parent of environment
-  // set to the closure's enclosed environment.
-  // Basically, run the function within the environment it was created
-  // within, with an extra layer to bind the arguments.
-  *environment = env_create(car(operator), 2 << 2);
-  list_set(*stack, 1, *environment);
-
-  // Bind arguments into local environment.
-  Atom arguments = list_get(*stack, 4);
-  Atom argument_names = car(cdr(operator));
+/// Bind each of ARGUMENTS to each of ARGUMENT-NAMES within ENVIRONMENT.
+static Error bind_arguments(Atom environment, Atom argument_names, Atom arguments) {
   // Prepare error
   MAKE_ERROR(error_args, ERROR_ARGUMENTS, arguments, "Could not bind arguments.", NULL);
   while (!nilp(argument_names)) {
     // Handle variadic arguments.
     if (symbolp(argument_names)) {
-      env_set(*environment, argument_names, arguments);
+      env_set(environment, argument_names, arguments);
       arguments = nil;
       break;
     }
@@ -119,7 +315,7 @@ Error evaluate_bind_arguments(Atom *stack, Atom *expr, Atom *environment) {
     }
 
     // Bind declared parameter name to passed argument value.
-    env_set(*environment, car(argument_names), car(arguments));
+    env_set(environment, car(argument_names), car(arguments));
 
     // Increment iterators.
     argument_names = cdr(argument_names);
@@ -130,91 +326,224 @@ Error evaluate_bind_arguments(Atom *stack, Atom *expr, Atom *environment) {
     error_args.suggestion = "Too many arguments passed.";
     return error_args;
   }
-  list_set(*stack, 4, nil);
-  return evaluate_next_expression(stack, expr, environment);
+  return ok;
+}
+
+static Error evaluate_bind_arguments(Atom *expr, Atom *environment) {
+  // If there is an existing body, then simply evaluate the next expression within it.
+  if (!nilp(FRAME.body)) {
+    return evaluate_next_expression(expr, environment);
+  }
+  // Else, bind the arguments into the current stack frame.
+
+  // Ensure operator is as expected (callable with arguments, not a builtin).
+  Atom operator = FRAME.operator;
+  if (!closurep(operator) && !macrop(operator)) {
+    MAKE_ERROR(err, ERROR_GENERIC, operator,
+               "evaluate_bind_arguments() requires operator to be a closure or macro when body is nil.",
+               NULL);
+    return err;
+  }
+
+  // Extract expression body from operator.
+  FRAME.body = cdr(cdr(operator));
+
+  // Create local environment for arguments, with parent of environment
+  // set to the closure's enclosed environment.
+  // Basically, run the function within the environment it was created
+  // within, with an extra layer to bind the arguments.
+  *environment = env_create_call(car(operator), car(cdr(operator)));
+  FRAME.environment = *environment;
+
+  // Bind arguments into local environment.
+  Error err = bind_arguments(*environment, car(cdr(operator)), FRAME.evaluated_arguments);
+  if (err.type) { return err; }
+  FRAME.evaluated_arguments = nil;
+  return evaluate_next_expression(expr, environment);
+}
+
+/// Return non-zero iff evaluation is being traced, in which case
+/// closures are interpreted so that every step shows up.
+static int debug_evaluation(void) {
+# ifdef LITE_DBG
+  return debug_evaluate.value || debug_macro.value || debug_while.value;
+# else
+  return 0;
+# endif
+}
+
+static Error evaluate_return_value(size_t base, Atom *expr, Atom *environment, Atom *result);
+
+/// Pop the top frame, handing RESULT to the frame beneath as the value
+/// of the expression it is waiting on.
+static Error evaluate_pop_with_result(size_t base, Atom *expr, Atom *environment, Atom *result) {
+  --frames_count;
+  if (frames_count == base) {
+    // Stop evaluating, with the result as the last expression.
+    *expr = cons(SYM(QUOTE), cons(*result, nil));
+    return ok;
+  }
+  return evaluate_return_value(base, expr, environment, result);
+}
+
+int evaluate_apply_target(Atom function, Atom arguments, Atom *closure) {
+  if (!listp(arguments)) { return 0; }
+  // Just like builtin_apply(), symbols are looked up globally.
+  if (symbolp(function) && env_get(*genv(), function, &function).type) {
+    return 0;
+  }
+  if (!closurep(function)) { return 0; }
+  *closure = function;
+  return 1;
 }
 
-Error evaluate_apply(Atom *stack, Atom *expr, Atom *environment) {
-  Atom operator = list_get(*stack, 2);
-  Atom arguments = list_get(*stack, 4);
+/// Call the builtin operator of the top frame through VECTOR with it's
+/// ARGC arguments, handing the result to the frame beneath.
+static Error evaluate_apply_vector(size_t base, Atom *expr, Atom *environment,
+                                   const BuiltInVector *vector, size_t argc) {
+  Atom argv[BUILTIN_VECTOR_ARITY_MAX];
+  Atom arguments = FRAME.evaluated_arguments;
+  // Arguments are last-is-first; no need to reverse them into a list.
+  for (size_t i = argc; i; arguments = cdr(arguments)) {
+    argv[--i] = car(arguments);
+  }
+  Atom result = nil;
+  Error err = builtin_vector_call(vector, argc, argv, &result);
+  if (err.type) {
+    if (err.type == ERROR_ARGUMENTS) {
+      arguments = FRAME.evaluated_arguments;
+      list_reverse(&arguments);
+      err.ref = cons(FRAME.operator, arguments);
+    }
+    return err;
+  }
+  return evaluate_pop_with_result(base, expr, environment, &result);
+}
+
+static Error evaluate_apply(size_t base, Atom *expr, Atom *environment) {
+  Atom operator = FRAME.operator;
+  Atom arguments = FRAME.evaluated_arguments;
+  if (builtinp(operator)) {
+    const BuiltInVector *vector = builtin_vector(operator.value.builtin->function);
+    size_t argc = 0;
+    for (Atom it = arguments; pairp(it) && argc <= BUILTIN_VECTOR_ARITY_MAX; it = cdr(it)) {
+      ++argc;
+    }
+    // Too many arguments are left for the list calling convention to report.
+    if (vector && argc <= BUILTIN_VECTOR_ARITY_MAX) {
+      return evaluate_apply_vector(base, expr, environment, vector, argc);
+    }
+  }
   if (!nilp(arguments)) {
     // Reverse arguments list. This is needed because of how we
     // evaluate them; they are added last-is-first.
     list_reverse(&arguments);
-    list_set(*stack, 4, arguments);
+    FRAME.evaluated_arguments = arguments;
   }
+  Atom closure = nil;
+  if (builtinp(operator)
+      && operator.value.builtin->function == builtin_apply
+      && pairp(arguments) && pairp(cdr(arguments)) && nilp(cdr(cdr(arguments)))
+      && evaluate_apply_target(car(arguments), car(cdr(arguments)), &closure))
+    {
+      // Apply the closure right here in place of APPLY, so it's body
+      // is evaluated on this stack rather than a recursive one.
+      operator = closure;
+      arguments = car(cdr(arguments));
+      FRAME.operator = operator;
+      FRAME.evaluated_arguments = arguments;
+    }
   if (symbolp(operator)) {
-    if (strcmp(operator.value.symbol, "WHILE-BODY") == 0) {
-      Atom body = list_get(*stack, 5);
+    SpecialForm form = special_form(operator);
+    if (form == SPECIAL_FORM_WHILE_BODY) {
+      Atom body = FRAME.body;
       assert(!nilp(body) && "WHILE-BODY: evaluate_apply should not be called when stack body is NIL!");
-      *environment = list_get(*stack, 1);
+      *environment = FRAME.environment;
       *expr = car(body);
-      body = cdr(body);
-      list_set(*stack, 5, body);
+      FRAME.body = cdr(body);
       return ok;
-    } else if (strcmp(operator.value.symbol, "PROGN") == 0) {
-      return evaluate_next_expression(stack, expr, environment);
+    } else if (form == SPECIAL_FORM_PROGN) {
+      return evaluate_next_expression(expr, environment);
     }
   } else if (builtinp(operator)) {
-    *stack = car(*stack);
+    --frames_count;
     *expr = cons(operator, arguments);
     return ok;
   } else if (operator.type != ATOM_TYPE_CLOSURE) {
-    print_stackframe(*stack, 0);
+    print_stackframes(base);
     MAKE_ERROR(err, ERROR_TYPE
                , operator
                , "APPLY: Expected operator type of #<BUILTIN> or #<CLOSURE>."
                , NULL);
     return err;
+  } else if (nilp(FRAME.body) && !debug_evaluation()) {
+    // Closures are run as bytecode; hand the result straight back to
+    // the parent stack frame as if it had been evaluated here.
+    char aborted = 0;
+    Atom result = nil;
+    Error err = bytecode_apply(operator, arguments, &result, &aborted);
+    if (err.type) { return err; }
+    if (aborted) {
+      // ERROR stops evaluation entirely.
+      frames_count = base;
+      *expr = cons(SYM(QUOTE), cons(result, nil));
+      return ok;
+    }
+    return evaluate_pop_with_result(base, expr, environment, &result);
   }
-  return evaluate_bind_arguments(stack, expr, environment);
+  return evaluate_bind_arguments(expr, environment);
 }
 
 /// EXPR is expected to be in form of '(OPERATOR . ARGUMENTS)'
-Error evaluate_return_value(Atom *stack, Atom *expr, Atom *environment, Atom *result) {
+static Error evaluate_return_value(size_t base, Atom *expr, Atom *environment, Atom *result) {
   Error err = ok;
-  *environment = list_get(*stack, 1);
-  Atom operator = list_get(*stack, 2);
-  Atom body = list_get(*stack, 5);
+  *environment = FRAME.environment;
+  Atom operator = FRAME.operator;
   Atom arguments = nil; // NOTE: Doesn't need initialised, if we're going for efficiency.
-  if (!nilp(body)) {
-    return evaluate_apply(stack, expr, environment);
+  if (!nilp(FRAME.body)) {
+    return evaluate_apply(base, expr, environment);
   }
   if (nilp(operator)) {
     // Operator has been evaluated.
     operator = *result;
-    list_set(*stack, 2, operator);
+    FRAME.operator = operator;
     if (macrop(operator)) {
-      arguments = list_get(*stack, 3);
-      *stack = make_frame(*stack, *environment, nil);
+      MacroExpansion *memo = macro_expansion_get(FRAME.form, operator);
+      if (memo) {
+        *expr = memo->expansion;
+        --frames_count;
+        return ok;
+      }
+      arguments = FRAME.pending_arguments;
+      push_frame(*environment, nil);
       operator.type = ATOM_TYPE_CLOSURE;
-      list_set(*stack, 2, operator);
-      list_set(*stack, 4, arguments);
+      FRAME.operator = operator;
+      FRAME.evaluated_arguments = arguments;
 #     ifdef LITE_DBG
-      if (env_non_nil(*environment, make_sym("DEBUG/MACRO"))) {
+      if (debug_macro.value) {
         printf("Evaluating macro: (");
         print_atom(*expr);
         putchar(' ');
-        print_atom(list_get(*stack, 4));
+        print_atom(arguments);
         printf(")\n");
       }
 #     endif
-      return evaluate_bind_arguments(stack, expr, environment);
+      return evaluate_bind_arguments(expr, environment);
     }
   } else if (symbolp(operator)) {
-    int define_locality = -1;
-    if ((define_locality = strcmp(operator.value.symbol, "DEFINE")) == 0
-        || (define_locality = !strcmp(operator.value.symbol, "SET")) != 0) {
+    SpecialForm form = special_form(operator);
+    switch (form) {
+    case SPECIAL_FORM_DEFINE:
+    case SPECIAL_FORM_SET: {
       // Here is where env_set is called, since
       // arguments have now been evaluated.
-      arguments = list_get(*stack, 4);
+      arguments = FRAME.evaluated_arguments;
       Atom symbol = car(arguments);
       Atom docstring = cdr(arguments);
       if(stringp(docstring)) {
-        result->docstring = strdup(docstring.value.symbol);
-        gcol_generic_allocation(result, result->docstring);
+        symbol_set_docstring(symbol, docstring.value.symbol);
       }
-      if (define_locality == 0) {
+      if (form == SPECIAL_FORM_DEFINE) {
         Atom containing = env_get_containing(*environment, symbol);
         if (nilp(containing)) {
           err = env_set(*environment, symbol, *result);
@@ -227,60 +556,49 @@ Error evaluate_return_value(Atom *stack, Atom *expr, Atom *environment, Atom *re
       if (err.type) {
         return err;
       }
-      *stack = car(*stack);
-      *expr = cons(make_sym("QUOTE"), cons(symbol, nil));
-      return ok;
-    } else if (strcmp(operator.value.symbol, "IF") == 0) {
-      arguments = list_get(*stack, 3);
+      // The value of a definition is the symbol that was defined.
+      *result = symbol;
+      return evaluate_pop_with_result(base, expr, environment, result);
+    }
+    case SPECIAL_FORM_IF: {
+      arguments = FRAME.pending_arguments;
       // `result` determines what to evaluate next ("then", or "else" branch).
       *expr = nilp(*result) ? car(cdr(arguments)) : car(arguments);
       // Continue execution, we've handled the IF entirely.
-      *stack = car(*stack);
+      --frames_count;
       return ok;
-    } else if (strcmp(operator.value.symbol, "PROGN") == 0) {
+    }
+    case SPECIAL_FORM_PROGN: {
       // Pop PROGN stack, we have finished evaluating it.
-      Atom new_stack = car(*stack);
-      if (!nilp(new_stack)) {
-        // Update stack environment. This is needed to allow
-        // for definitions in the body to affect outside of it.
-        list_set(new_stack, 1, list_get(*stack, 1));
-      }
-      *stack = new_stack;
+      pop_frame_keep_environment(base);
       *expr = *result; // Return result of last expression of body.
       return ok;
-    } else if (strcmp(operator.value.symbol, "EVALUATE") == 0) {
+    }
+    case SPECIAL_FORM_EVALUATE: {
       // Pop EVALUATE stack, we have finished evaluating it.
-      Atom new_stack = car(*stack);
-      if (!nilp(new_stack)) {
-        // Update stack environment. This is needed to allow
-        // for definitions in the body to affect outside of it.
-        list_set(new_stack, 1, list_get(*stack, 1));
-      }
-      *stack = new_stack;
+      pop_frame_keep_environment(base);
       *expr = *result; // Return result of expression.
       return ok;
-    } else if (strcmp(operator.value.symbol, "WHILE") == 0) {
-      arguments = list_get(*stack, 3);
+    }
+    case SPECIAL_FORM_WHILE: {
+      arguments = FRAME.pending_arguments;
 
-      // Store recurse count in evaluated arguments list.
-      Atom recurse_count = list_get(*stack, 4);
+      // Store recurse count in evaluated arguments.
+      Atom recurse_count = FRAME.evaluated_arguments;
       if (!integerp(recurse_count)) {
         recurse_count = make_int(0);
       } else {
         recurse_count.value.integer += 1;
       }
-      Atom recurse_maximum = nil;
-      env_get(*environment, make_sym("WHILE-RECURSE-LIMIT"), &recurse_maximum);
-      if (!integerp(recurse_maximum)) { recurse_maximum = make_int(10000); }
-      list_set(*stack, 4, recurse_count);
+      integer_t recurse_maximum = while_recurse_limit.value;
+      FRAME.evaluated_arguments = recurse_count;
 
 #     ifdef LITE_DBG
-      int debug_while = env_non_nil(*environment, make_sym("DEBUG/WHILE"));
-      if (debug_while) {
+      if (debug_while.value) {
         printf("WHILE: recurse count is ");
         print_atom(recurse_count);
         printf(" (max ");
-        print_atom(recurse_maximum);
+        print_atom(make_int(recurse_maximum));
         printf(")\n");
         printf("  condition: ");
         print_atom(car(arguments));
@@ -298,69 +616,64 @@ Error evaluate_return_value(Atom *stack, Atom *expr, Atom *environment, Atom *re
 
       // At this point, result contains condition return value.
       // If result is nil, or maximum recursion limit has been reached, exit the loop.
-      if (nilp(*result) || recurse_count.value.integer >= recurse_maximum.value.integer) {
+      if (nilp(*result) || recurse_count.value.integer >= recurse_maximum) {
 #       ifdef LITE_DBG
-        if (debug_while) { printf("  Loop ending.\n"); }
+        if (debug_while.value) { printf("  Loop ending.\n"); }
 #       endif
-        *stack = car(*stack);
-        return ok;
+        return evaluate_pop_with_result(base, expr, environment, result);
       }
 #     ifdef LITE_DBG
-      if (debug_while) { printf("  Loop continuing.\n"); }
+      if (debug_while.value) { printf("  Loop continuing.\n"); }
 #     endif
-      *stack = make_frame(*stack, *environment, nil);
-      list_set(*stack, 2, make_sym("WHILE-BODY"));
-      list_set(*stack, 5, cdr(arguments));
-      return evaluate_next_expression(stack, expr, environment);
-    } else if (strcmp(operator.value.symbol, "WHILE-BODY") == 0) {
+      push_frame(*environment, nil);
+      FRAME.operator = SYM(WHILE_BODY);
+      // WHILE-BODY stays on the stack until it's last expression has
+      // been evaluated, even when that's the first, so that the
+      // condition is re-evaluated afterwards.
+      *expr = car(cdr(arguments));
+      FRAME.body = cdr(cdr(arguments));
+      return ok;
+    }
+    case SPECIAL_FORM_WHILE_BODY: {
       // Pop WHILE-BODY stack, we have finished evaluating it.
-      Atom new_stack = car(*stack);
-      // Update WHILE stack environment. This is needed to allow
-      // for definitions in the body to affect the conditional.
-      list_set(new_stack, 1, list_get(*stack, 1));
-      *stack = new_stack;
-      *expr = *result;
+      // Keeping the environment is needed to allow for definitions in
+      // the body to affect the conditional.
+      pop_frame_keep_environment(base);
       // Re-evaluate condition before continuing.
-      *expr = car(list_get(*stack, 3));
+      *expr = car(FRAME.pending_arguments);
       return ok;
-    } else if (strcmp(operator.value.symbol, "OR") == 0) {
-      arguments = list_get(*stack, 3);
-      if (!nilp(*result)) {
-        *stack = car(*stack);
-        return ok;
-      }
-      if (nilp(cdr(arguments))) {
-        *stack = car(*stack);
-        return ok;
+    }
+    case SPECIAL_FORM_OR: {
+      arguments = FRAME.pending_arguments;
+      if (!nilp(*result) || nilp(cdr(arguments))) {
+        return evaluate_pop_with_result(base, expr, environment, result);
       }
       *expr = car(cdr(arguments));
-      list_set(*stack, 3, cdr(arguments));
+      FRAME.pending_arguments = cdr(arguments);
       return ok;
-    } else if (strcmp(operator.value.symbol, "AND") == 0) {
-      arguments = list_get(*stack, 3);
-      if (nilp(*result)) {
-        *stack = car(*stack);
-        return ok;
-      }
-      if (nilp(cdr(arguments))) {
-        *stack = car(*stack);
-        return ok;
+    }
+    case SPECIAL_FORM_AND: {
+      arguments = FRAME.pending_arguments;
+      if (nilp(*result) || nilp(cdr(arguments))) {
+        return evaluate_pop_with_result(base, expr, environment, result);
       }
       *expr = car(cdr(arguments));
-      list_set(*stack, 3, cdr(arguments));
+      FRAME.pending_arguments = cdr(arguments);
       return ok;
-    } else {
+    }
+    default:
       // Store arguments.
-      arguments = list_get(*stack, 4);
-      list_set(*stack, 4, cons(*result, arguments));
+      FRAME.evaluated_arguments = cons(*result, FRAME.evaluated_arguments);
+      break;
     }
   } else if (macrop(operator)) {
     // This is where the return value of macros are evaluated.
     *expr = *result;
-    *stack = car(*stack);
+    macro_expansion_insert(FRAME.form, operator, *result);
+    --frames_count;
 
 #   ifdef LITE_DBG
-    if (env_non_nil(*environment, make_sym("DEBUG/MACRO"))) {
+    if (debug_macro.value) {
       printf("          result: ");
       print_atom(*result);
       putchar('\n');
@@ -371,48 +684,495 @@ Error evaluate_return_value(Atom *stack, Atom *expr, Atom *environment, Atom *re
   } else {
     // Store argument
     // NOTE: This stores arguments in reverse order (last is first).
-    arguments = list_get(*stack, 4);
-    list_set(*stack, 4, cons(*result, arguments));
+    FRAME.evaluated_arguments = cons(*result, FRAME.evaluated_arguments);
   }
 
   // The rest of the arguments to evaluate.
-  arguments = list_get(*stack, 3);
+  arguments = FRAME.pending_arguments;
   // No arguments left to evaluate, apply operator with gathered arguments.
   if (nilp(arguments)) {
-    return evaluate_apply(stack, expr, environment);
+    return evaluate_apply(base, expr, environment);
   }
   // Otherwise, evaluate next argument.
   *expr = car(arguments);
   // Eat next argument from unevaluated arguments list.
-  list_set(*stack, 3, cdr(arguments));
+  FRAME.pending_arguments = cdr(arguments);
+  return ok;
+}
+
+// These numbers are tailored to free around twenty mebibytes at a time,
+// and to have both of the reasons for garbage collection actually used.
+#define gcol_pair_allocations_threshold_default     290500
+#define gcol_evaluation_iteration_threshold_default 100000
+static size_t evaluation_iterations_until_gcol = gcol_evaluation_iteration_threshold_default;
+static WatchedVariable gcol_pair_allocations_threshold = WATCHED_INTEGER_VARIABLE
+  ("GARBAGE-COLLECTOR-PAIR-ALLOCATIONS-THRESHOLD", gcol_pair_allocations_threshold_default);
+static WatchedVariable gcol_evaluation_iteration_threshold = WATCHED_INTEGER_VARIABLE
+  ("GARBAGE-COLLECTOR-EVALUATION-ITERATIONS-THRESHOLD", gcol_evaluation_iteration_threshold_default);
+
+// Most collections are minor, and only free what has been allocated
+// since the one before. Every so often, or once what has survived
+// takes up half of the pair allocations threshold, a major collection
+// frees everything that has since gone out of use.
+#define gcol_minor_collections_per_major 8
+static size_t gcol_minor_collections_until_major = 0;
+static size_t gcol_pairs_survived = 0;
+
+// Major collections are marked a little at a time, every hundred
+// evaluation iterations, so that no single pause takes much longer
+// than this many microseconds.
+#define gcol_pause_budget_default 2000
+static WatchedVariable gcol_pause_budget = WATCHED_INTEGER_VARIABLE
+  ("GARBAGE-COLLECTOR-PAUSE-BUDGET", gcol_pause_budget_default);
+/// Non-zero while a major collection is being marked incrementally.
+static char gcol_incremental = 0;
+
+// Once every root has been found, marking through what they refer to
+// may be spread across this many threads.
+static WatchedVariable gcol_mark_threads = WATCHED_INTEGER_VARIABLE
+  ("GARBAGE-COLLECTOR-MARK-THREADS", 1);
+
+/// Upper bounds of the buckets of the pause histogram, in
+/// microseconds. Longer pauses go in one last bucket of their own.
+static const integer_t gcol_pause_buckets[] = {
+  50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000
+};
+#define GCOL_PAUSE_BUCKETS (sizeof gcol_pause_buckets / sizeof *gcol_pause_buckets)
+
+/// Why a collection was started.
+typedef enum GcolTrigger {
+  GCOL_TRIGGER_PAIR_ALLOCATIONS,
+  GCOL_TRIGGER_EVALUATION_ITERATIONS,
+  GCOL_TRIGGER_TRANSIENT_EVALUATION,
+  GCOL_TRIGGER_MAX,
+} GcolTrigger;
+
+static const char *const gcol_trigger_names[GCOL_TRIGGER_MAX] = {
+  "PAIR-ALLOCATIONS-THRESHOLD",
+  "EVALUATION-ITERATIONS-THRESHOLD",
+  "TRANSIENT-EVALUATION",
+};
+
+/// Everything GARBAGE-COLLECTOR-STATISTICS reports, besides the census.
+static struct GcolStatistics {
+  size_t minor_collections;
+  size_t major_collections;
+  /// Every time evaluation is stopped for garbage collection, in
+  /// microseconds. An incremental collection pauses many times.
+  size_t pauses;
+  integer_t pause_last;
+  integer_t pause_max;
+  integer_t pause_total;
+  size_t pause_histogram[GCOL_PAUSE_BUCKETS + 1];
+  char triggered;
+  GcolTrigger trigger;
+  size_t triggers[GCOL_TRIGGER_MAX];
+  /// Pairs allocated in between the previous collection and a minor
+  /// collection, and how many of those were still in use by it.
+  size_t young_pairs;
+  size_t promoted_pairs;
+} gcol_statistics;
+
+/// Pairs allocated in total as of the end of the previous collection.
+static size_t gcol_pairs_allocated = 0;
+
+/// Return the current time in microseconds, since whenever.
+static integer_t gcol_now(void) {
+  struct timespec now;
+  if (!timespec_get(&now, TIME_UTC)) {
+    return 0;
+  }
+  return (integer_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+/// Record a pause for garbage collection that began at BEGAN.
+static void gcol_pause_record(integer_t began) {
+  integer_t pause = gcol_now() - began;
+  if (pause < 0) {
+    pause = 0;
+  }
+  size_t bucket = 0;
+  while (bucket < GCOL_PAUSE_BUCKETS && pause > gcol_pause_buckets[bucket]) {
+    ++bucket;
+  }
+  gcol_statistics.pause_histogram[bucket] += 1;
+  gcol_statistics.pauses += 1;
+  gcol_statistics.pause_last = pause;
+  gcol_statistics.pause_total += pause;
+  if (pause > gcol_statistics.pause_max) {
+    gcol_statistics.pause_max = pause;
+  }
+}
+
+void evaluation_watch_variables(void) {
+  env_watch(&while_recurse_limit);
+  env_watch(&gcol_pair_allocations_threshold);
+  env_watch(&gcol_evaluation_iteration_threshold);
+  env_watch(&gcol_pause_budget);
+  env_watch(&gcol_mark_threads);
+# ifdef LITE_DBG
+  env_watch(&debug_evaluate);
+  env_watch(&debug_macro);
+  env_watch(&debug_while);
+  env_watch(&debug_memory);
+# endif
+}
+
+static integer_t evaluation_pair_allocations_threshold(void) {
+  integer_t pair_allocations_threshold = gcol_pair_allocations_threshold.value;
+  if (pair_allocations_threshold <= 0) {
+    pair_allocations_threshold = gcol_pair_allocations_threshold_default;
+  }
+  return pair_allocations_threshold;
+}
+
+static void evaluation_gcol_reset_iterations(void) {
+  size_t iterations_threshold = gcol_evaluation_iteration_threshold_default;
+  if (gcol_evaluation_iteration_threshold.value > 0) {
+    iterations_threshold = (size_t)gcol_evaluation_iteration_threshold.value;
+  }
+  evaluation_iterations_until_gcol = iterations_threshold;
+}
+
+/// Mark every root, finish marking, and sweep.
+static void evaluation_gcol_finish(char major) {
+  size_t pair_allocations_freed_before = pair_allocations_freed;
+  size_t generic_allocations_freed_before = generic_allocations_freed;
+  evaluation_gcol_reset_iterations();
+  gcol_shade(genv());
+  gcol_shade(buf_table());
+  gcol_shade_roots();
+  for (size_t i = 0; i < frames_count; ++i) {
+    gcol_shade(&frames[i].environment);
+    gcol_shade(&frames[i].operator);
+    gcol_shade(&frames[i].pending_arguments);
+    gcol_shade(&frames[i].evaluated_arguments);
+    gcol_shade(&frames[i].body);
+    gcol_shade(&frames[i].form);
+  }
+  if (gcol_mark_threads.value > 1) {
+    gcol_mark_gray_parallel((size_t)gcol_mark_threads.value);
+  } else {
+    gcol_mark_gray(-1);
+  }
+  bytecode_mark();
+  macro_expansions_mark();
+  bytecode_sweep();
+  macro_expansions_sweep();
+  gcol();
+  gcol_incremental = 0;
+  gcol_pairs_survived = pair_allocations_count - pair_allocations_freed;
+  if (major) {
+    gcol_statistics.major_collections += 1;
+  } else {
+    // Only what was allocated since the previous collection is freed by
+    // a minor one; the rest of it is now old.
+    size_t young = pair_allocations_count - gcol_pairs_allocated;
+    gcol_statistics.minor_collections += 1;
+    gcol_statistics.young_pairs += young;
+    gcol_statistics.promoted_pairs += young - (pair_allocations_freed - pair_allocations_freed_before);
+  }
+  gcol_pairs_allocated = pair_allocations_count;
+# ifdef LITE_DBG
+  if (debug_memory.value) {
+    size_t pair_allocations_freed_this_iteration =
+      pair_allocations_freed - pair_allocations_freed_before;
+    size_t generic_allocations_freed_this_iteration =
+      generic_allocations_freed - generic_allocations_freed_before;
+    size_t pair_allocations_bytes_freed =
+      pair_allocations_freed_this_iteration * sizeof(Pair);
+    size_t generic_allocations_bytes_freed =
+      generic_allocations_freed_this_iteration * sizeof(GenericAllocation);
+    printf("Garbage Collected (%s)\n", major ? "major" : "minor");
+    print_gcol_data();
+    printf("This iteration:\n"
+           "|-- %zu pairs freed (%zu bytes)\n"
+           "|-- %zu generics freed (%zu bytes)\n"
+           "`-- %zu bytes freed\n",
+           pair_allocations_freed_this_iteration,
+           pair_allocations_bytes_freed,
+           generic_allocations_freed_this_iteration,
+           generic_allocations_bytes_freed,
+           pair_allocations_bytes_freed + generic_allocations_bytes_freed);
+    printf("=====\n");
+  }
+# else
+  (void)generic_allocations_freed_before;
+# endif
+}
+
+/// Mark a pause budget's worth of the major collection in progress,
+/// finishing it if there's nothing left to mark, or if garbage is
+/// piling up faster than it's being marked.
+static void evaluation_gcol_increment(void) {
+  integer_t began = gcol_now();
+  size_t pairs_in_use = pair_allocations_count - pair_allocations_freed;
+  if (gcol_mark_gray(gcol_pause_budget.value)
+      || pairs_in_use >= 2 * (size_t)evaluation_pair_allocations_threshold())
+    {
+      evaluation_gcol_finish(1);
+    }
+  gcol_pause_record(began);
+}
+
+void evaluation_gcol_idle(void) {
+  if (gcol_incremental) {
+    evaluation_gcol_increment();
+  }
+}
+
+void evaluation_gcol_step(void) {
+  char should_gcol = 0;
+  GcolTrigger trigger = GCOL_TRIGGER_EVALUATION_ITERATIONS;
+  if (!--evaluation_iterations_until_gcol) { should_gcol = 1; }
+  // Check pair allocations count every 100 evaluation iterations.
+  if (!should_gcol && evaluation_iterations_until_gcol % 100 == 0) {
+    if (gcol_incremental) {
+      evaluation_gcol_increment();
+      return;
+    }
+    size_t pairs_in_use = pair_allocations_count - pair_allocations_freed;
+    // TODO: Error on overflow
+    if (pairs_in_use >= (size_t)evaluation_pair_allocations_threshold()) {
+      should_gcol = 1;
+      trigger = GCOL_TRIGGER_PAIR_ALLOCATIONS;
+    }
+  }
+  if (!should_gcol) {
+    return;
+  }
+  if (gcol_incremental) {
+    // Taking too long; get it over with.
+    integer_t began = gcol_now();
+    evaluation_gcol_finish(1);
+    gcol_pause_record(began);
+    return;
+  }
+  char major = !gcol_minor_collections_until_major
+    || gcol_pairs_survived >= (size_t)evaluation_pair_allocations_threshold() / 2;
+  if (major) {
+    gcol_minor_collections_until_major = gcol_minor_collections_per_major;
+  } else {
+    --gcol_minor_collections_until_major;
+  }
+  char incremental = major && gcol_pause_budget.value > 0;
+# ifdef LITE_DBG
+  if (debug_memory.value) {
+    printf("=====\nCollecting Garbage (%s): ",
+           incremental ? "major, incremental" : major ? "major" : "minor");
+    if (evaluation_iterations_until_gcol) {
+      printf("pair allocations threshold reached\n");
+    } else {
+      printf("evaluation iterations threshold reached\n");
+    }
+    print_gcol_data();
+    printf("VVVVV\n");
+  }
+# endif
+  gcol_statistics.triggered = 1;
+  gcol_statistics.trigger = trigger;
+  gcol_statistics.triggers[trigger] += 1;
+  integer_t began = gcol_now();
+  if (incremental) {
+    // Everything else is marked when finishing, anyway.
+    gcol_start_incremental();
+    gcol_shade(genv());
+    gcol_shade(buf_table());
+    gcol_incremental = 1;
+    evaluation_gcol_reset_iterations();
+  } else {
+    gcol_start(major);
+    evaluation_gcol_finish(major);
+  }
+  gcol_pause_record(began);
+}
+
+Error evaluate_expression_transient(Atom expr, Atom environment, Atom *result) {
+  // Regions don't nest, and the region can't be collected on it's own
+  // while a major collection is being marked.
+  if (gcol_incremental || gcol_region_active()) {
+    return evaluate_expression(expr, environment, result);
+  }
+  gcol_region_begin();
+  Error err = evaluate_expression(expr, environment, result);
+  if (!gcol_region_active()) {
+    // A collection was started in the meantime, which has already
+    // dealt with the region.
+    return err;
+  }
+  gcol_root_push(&expr);
+  gcol_root_push(&environment);
+  gcol_root_push(result);
+  gcol_root_push(&err.ref);
+  gcol_statistics.triggered = 1;
+  gcol_statistics.trigger = GCOL_TRIGGER_TRANSIENT_EVALUATION;
+  gcol_statistics.triggers[GCOL_TRIGGER_TRANSIENT_EVALUATION] += 1;
+  integer_t began = gcol_now();
+  gcol_start_region();
+  evaluation_gcol_finish(0);
+  gcol_pause_record(began);
+  gcol_root_pop(4);
+  return err;
+}
+
+/// Return a cons of KEY, as a symbol, and VALUE.
+static Atom gcol_statistic(char *key, Atom value) {
+  return cons(make_sym(key), value);
+}
+
+static Atom gcol_statistic_int(char *key, size_t value) {
+  return gcol_statistic(key, make_int((integer_t)value));
+}
+
+Atom evaluation_gcol_statistics(void) {
+  Atom statistics = nil;
+  list_push(&statistics, gcol_statistic_int("MINOR-COLLECTIONS", gcol_statistics.minor_collections));
+  list_push(&statistics, gcol_statistic_int("MAJOR-COLLECTIONS", gcol_statistics.major_collections));
+
+  Atom trigger = nil;
+  if (gcol_statistics.triggered) {
+    trigger = make_sym((char *)gcol_trigger_names[gcol_statistics.trigger]);
+  }
+  list_push(&statistics, gcol_statistic("TRIGGER", trigger));
+  Atom triggers = nil;
+  for (size_t i = GCOL_TRIGGER_MAX; i-- > 0;) {
+    list_push(&triggers, gcol_statistic_int((char *)gcol_trigger_names[i], gcol_statistics.triggers[i]));
+  }
+  list_push(&statistics, gcol_statistic("TRIGGERS", triggers));
+
+  list_push(&statistics, gcol_statistic_int("PAUSES", gcol_statistics.pauses));
+  list_push(&statistics, gcol_statistic("PAUSE-LAST", make_int(gcol_statistics.pause_last)));
+  list_push(&statistics, gcol_statistic("PAUSE-MAX", make_int(gcol_statistics.pause_max)));
+  list_push(&statistics, gcol_statistic("PAUSE-TOTAL", make_int(gcol_statistics.pause_total)));
+  Atom histogram = nil;
+  for (size_t i = GCOL_PAUSE_BUCKETS + 1; i-- > 0;) {
+    Atom bound = i < GCOL_PAUSE_BUCKETS ? make_int(gcol_pause_buckets[i]) : SYM(T);
+    list_push(&histogram, cons(bound, make_int((integer_t)gcol_statistics.pause_histogram[i])));
+  }
+  list_push(&statistics, gcol_statistic("PAUSE-HISTOGRAM", histogram));
+
+  list_push(&statistics, gcol_statistic_int("YOUNG-PAIRS", gcol_statistics.young_pairs));
+  list_push(&statistics, gcol_statistic_int("PROMOTED-PAIRS", gcol_statistics.promoted_pairs));
+  size_t promotion_percent = 0;
+  if (gcol_statistics.young_pairs) {
+    promotion_percent = gcol_statistics.promoted_pairs * 100 / gcol_statistics.young_pairs;
+  }
+  list_push(&statistics, gcol_statistic_int("PROMOTION-PERCENT", promotion_percent));
+
+  static const struct {
+    char *name;
+    enum AtomType type;
+  } census_types[] = {
+    { "PAIRS",        ATOM_TYPE_PAIR },
+    { "STRINGS",      ATOM_TYPE_STRING },
+    { "ENVIRONMENTS", ATOM_TYPE_ENVIRONMENT },
+    { "BUFFERS",      ATOM_TYPE_BUFFER },
+    { "CLOSURES",     ATOM_TYPE_CLOSURE },
+    { "MACROS",       ATOM_TYPE_MACRO },
+  };
+  const GcolCensus *census = gcol_census();
+  Atom live = nil;
+  for (size_t i = sizeof census_types / sizeof *census_types; i-- > 0;) {
+    enum AtomType type = census_types[i].type;
+    Atom counts = cons(make_int((integer_t)census->objects[type]),
+                       cons(make_int((integer_t)census->bytes[type]), nil));
+    list_push(&live, gcol_statistic(census_types[i].name, counts));
+  }
+  list_push(&statistics, gcol_statistic("LIVE", live));
+
+  list_reverse(&statistics);
+  return statistics;
+}
+
+Error evaluate_macro_expand(Atom macro, Atom arguments, Atom *expansion) {
+  gcol_root_push(&macro);
+  gcol_root_push(&arguments);
+  Atom environment = env_create_call(car(macro), car(cdr(macro)));
+  gcol_root_push(&environment);
+  Error err = bind_arguments(environment, car(cdr(macro)), arguments);
+  *expansion = nil;
+  for (Atom body = cdr(cdr(macro)); !err.type && !nilp(body); body = cdr(body)) {
+    err = evaluate_expression(car(body), environment, expansion);
+  }
+  gcol_root_pop(3);
+  return err;
+}
+
+/// Return code that evaluates to TEMPLATE, which is constant.
+static Atom quasiquote_constant(Atom template) {
+  if (nilp(template)) { return nil; }
+  Atom quoted = cons(SYM(QUOTE), cons(template, nil));
+  if (!pairp(template)) { return quoted; }
+  return cons(SYM(COPY), cons(quoted, nil));
+}
+
+/// Set EXPANSION to the code that builds TEMPLATE, unless it's a
+/// constant, in which case CONSTANT is set and EXPANSION is not.
+static Error quasiquote_expand(Atom template, Atom *expansion, char *constant) {
+  *constant = 0;
+  if (!pairp(template)) {
+    *constant = 1;
+    return ok;
+  }
+  Atom operator = car(template);
+  if (symbolp(operator) && operator.value.symbol == SYM(UNQUOTE).value.symbol) {
+    if (!pairp(cdr(template)) || !nilp(cdr(cdr(template)))) {
+      MAKE_ERROR(err, ERROR_ARGUMENTS
+                 , template
+                 , "UNQUOTE: Only a single argument may be passed."
+                 , NULL);
+      return err;
+    }
+    *expansion = car(cdr(template));
+    return ok;
+  }
+  Atom rest = nil;
+  char rest_constant = 0;
+  Error err = quasiquote_expand(cdr(template), &rest, &rest_constant);
+  if (err.type) { return err; }
+  if (rest_constant) { rest = quasiquote_constant(cdr(template)); }
+  if (pairp(operator) && symbolp(car(operator))
+      && car(operator).value.symbol == SYM(UNQUOTE_SPLICING).value.symbol)
+    {
+      if (!pairp(cdr(operator)) || !nilp(cdr(cdr(operator)))) {
+        PREP_ERROR(err, ERROR_ARGUMENTS
+                   , operator
+                   , "UNQUOTE-SPLICING: Only a single argument may be passed."
+                   , NULL);
+        return err;
+      }
+      *expansion = cons(SYM(APPEND), cons(car(cdr(operator)), cons(rest, nil)));
+      return ok;
+    }
+  Atom first = nil;
+  char first_constant = 0;
+  err = quasiquote_expand(operator, &first, &first_constant);
+  if (err.type) { return err; }
+  if (first_constant && rest_constant) {
+    *constant = 1;
+    return ok;
+  }
+  if (first_constant) { first = quasiquote_constant(operator); }
+  *expansion = cons(SYM(CONS), cons(first, cons(rest, nil)));
+  return ok;
+}
+
+Error evaluate_quasiquote_expand(Atom template, Atom *expansion) {
+  char constant = 0;
+  Error err = quasiquote_expand(template, expansion, &constant);
+  if (err.type) { return err; }
+  if (constant) { *expansion = quasiquote_constant(template); }
   return ok;
 }
 
 Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
   MAKE_ERROR(err, ERROR_NONE, nil, NULL, NULL);
-  Atom stack = nil;
-
-#define FOR_ALL_GCOL_THINGS(F)                  \
-    F(&expr);                                   \
-    F(result);                                  \
-    F(genv());                                  \
-    F(&environment);                            \
-    F(&stack);                                  \
-    F(buf_table())
-
-#define UNMARK_ALL_GCOL_THINGS(n)               \
-    gcol_unmark(&expr, n);                      \
-    gcol_unmark(result, n);                     \
-    gcol_unmark(genv(), n);                     \
-    gcol_unmark(&environment, n);               \
-    gcol_unmark(&stack, n);                     \
-    gcol_unmark(buf_table(), n)
-
-  // These numbers are tailored to free around twenty mebibytes at a time,
-  // and to have both of the reasons for garbage collection actually used.
-# define gcol_pair_allocations_threshold_default     290500
-# define gcol_evaluation_iteration_threshold_default 100000
-  static size_t evaluation_iterations_until_gcol = gcol_evaluation_iteration_threshold_default;
+  // Frames beneath this belong to whoever called us.
+  size_t base = frames_count;
+
+  gcol_root_push(&expr);
+  gcol_root_push(result);
+  gcol_root_push(&environment);
   do {
 
     // Handle Quit
@@ -421,75 +1181,7 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
     }
 
     // Garbage Collection
-    char should_gcol = 0;
-    if (!--evaluation_iterations_until_gcol) { should_gcol = 1; }
-    // Check pair allocations count every 100 evaluation iterations.
-    if (!should_gcol && evaluation_iterations_until_gcol % 100 == 0) {
-      Atom pair_allocations_threshold = nil;
-      err = env_get(environment, make_sym("GARBAGE-COLLECTOR-PAIR-ALLOCATIONS-THRESHOLD"),
-                    &pair_allocations_threshold);
-      if (err.type) { err = ok; }
-      if (!integerp(pair_allocations_threshold) || pair_allocations_threshold.value.integer <= 0) {
-        pair_allocations_threshold = make_int(gcol_pair_allocations_threshold_default);
-      }
-      size_t pairs_in_use = pair_allocations_count - pair_allocations_freed;
-      // TODO: Error on overflow
-      if (pairs_in_use >= (size_t)pair_allocations_threshold.value.integer) {
-        should_gcol = 1;
-      }
-    }
-    if (should_gcol) {
-      size_t pair_allocations_freed_before = pair_allocations_freed;
-      size_t generic_allocations_freed_before = generic_allocations_freed;
-#     ifdef LITE_DBG
-      Atom debug_memory = nil;
-      env_get(environment, make_sym("DEBUG/MEMORY"), &debug_memory);
-      if (!nilp(debug_memory)) {
-        printf("=====\nCollecting Garbage: ");
-        if (evaluation_iterations_until_gcol) {
-          printf("pair allocations threshold reached\n");
-        } else {
-          printf("evaluation iterations threshold reached\n");
-        }
-        print_gcol_data();
-        printf("VVVVV\n");
-      }
-#     endif
-      size_t iterations_threshold = gcol_evaluation_iteration_threshold_default;
-      Atom threshold_atom = nil;
-      err = env_get(environment, make_sym("GARBAGE-COLLECTOR-EVALUATION-ITERATIONS-THRESHOLD"), &threshold_atom);
-      if (err.type) { print_error(err); err = ok; }
-      else if (integerp(threshold_atom) && threshold_atom.value.integer > 0) {
-        iterations_threshold = (size_t)threshold_atom.value.integer;
-      }
-      evaluation_iterations_until_gcol = iterations_threshold;
-      FOR_ALL_GCOL_THINGS(gcol_mark);
-      gcol();
-#     ifdef LITE_DBG
-      if (!nilp(debug_memory)) {
-        size_t pair_allocations_freed_this_iteration =
-          pair_allocations_freed - pair_allocations_freed_before;
-        size_t generic_allocations_freed_this_iteration =
-          generic_allocations_freed - generic_allocations_freed_before;
-        size_t pair_allocations_bytes_freed =
-          pair_allocations_freed_this_iteration * sizeof(ConsAllocation);
-        size_t generic_allocations_bytes_freed =
-          generic_allocations_freed_this_iteration * sizeof(GenericAllocation);
-        printf("Garbage Collected\n");
-        print_gcol_data();
-        printf("This iteration:\n"
-               "|-- %zu pairs freed (%zu bytes)\n"
-               "|-- %zu generics freed (%zu bytes)\n"
-               "`-- %zu bytes freed\n",
-               pair_allocations_freed_this_iteration,
-               pair_allocations_bytes_freed,
-               generic_allocations_freed_this_iteration,
-               generic_allocations_bytes_freed,
-               pair_allocations_bytes_freed + generic_allocations_bytes_freed);
-        printf("=====\n");
-      }
-#     endif
-    }
+    evaluation_gcol_step();
 
     // Expression Evaluation
 
@@ -505,7 +1197,7 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
       Atom operator = car(expr);
       Atom arguments = cdr(expr);
 #     ifdef LITE_DBG
-      if (env_non_nil(environment, make_sym("DEBUG/EVALUATE"))) {
+      if (debug_evaluate.value) {
         printf("Evaluating expression: ");
         print_atom(expr);
         putchar('\n');
@@ -519,17 +1211,40 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
 #     endif
       if (symbolp(operator)) {
         // Special forms
-        if (strcmp(operator.value.symbol, "QUOTE") == 0) {
+        switch (special_form(operator)) {
+        case SPECIAL_FORM_QUOTE:
           if (nilp(arguments) || !nilp(cdr(arguments))) {
             PREP_ERROR(err, ERROR_ARGUMENTS
                        , arguments
                        , "QUOTE: Only a single argument may be passed."
                        , NULL);
-            return err;
+            break;
           }
           *result = car(arguments);
-        } else if (strcmp(operator.value.symbol, "DEFINE") == 0
-                   || strcmp(operator.value.symbol, "SET") == 0) {
+          break;
+        case SPECIAL_FORM_QUASIQUOTE: {
+          if (nilp(arguments) || !nilp(cdr(arguments))) {
+            PREP_ERROR(err, ERROR_ARGUMENTS
+                       , arguments
+                       , "QUASIQUOTE: Only a single argument may be passed."
+                       , NULL);
+            break;
+          }
+          // Expanded once, just like a macro application.
+          MacroExpansion *memo = macro_expansion_get(expr, nil);
+          if (memo) {
+            expr = memo->expansion;
+            continue;
+          }
+          Atom expansion = nil;
+          err = evaluate_quasiquote_expand(car(arguments), &expansion);
+          if (err.type) { break; }
+          macro_expansion_insert(expr, nil, expansion);
+          expr = expansion;
+          continue;
+        }
+        case SPECIAL_FORM_DEFINE:
+        case SPECIAL_FORM_SET: {
           const char *usage_define = "Usage: (DEFINE <symbol> <value> [docstring])";
           // Ensure at least two arguments.
           if (nilp(arguments) || nilp(cdr(arguments))) {
@@ -537,7 +1252,7 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                        , arguments
                        , "DEFINE: Not enough arguments."
                        , usage_define);
-            return err;
+            break;
           }
           // Get docstring, if present.
           Atom doc = nil;
@@ -548,7 +1263,7 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                          , arguments
                          , "DEFINE: Too many arguments."
                          , usage_define);
-              return err;
+              break;
             }
             doc = car(cdr(cdr(arguments)));
             if (doc.type != ATOM_TYPE_STRING) {
@@ -556,7 +1271,7 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                          , doc
                          , "DEFINE: Docstring must be a string!\n  Strings are text wrapped in double quotes."
                          , usage_define)
-                return err;
+                break;
             }
           }
           Atom symbol = car(arguments);
@@ -565,25 +1280,28 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                        , symbol
                        , "DEFINE: The first argument must be a symbol."
                        , usage_define);
-            return err;
+            break;
           }
           // Create a new stack to evaluate definition of new symbol.
-          stack = make_frame(stack, environment, nil);
-          list_set(stack, 2, operator);
-          list_set(stack, 4, cons(symbol, doc));
+          push_frame(environment, nil);
+          FRAME.operator = operator;
+          FRAME.evaluated_arguments = cons(symbol, doc);
           expr = car(cdr(arguments));
           continue;
-        } else if (strcmp(operator.value.symbol, "LAMBDA") == 0) {
+        }
+        case SPECIAL_FORM_LAMBDA: {
           const char *usage_lambda = "Usage: (LAMBDA <argument> <body>...)";
           if (nilp(arguments) || nilp(cdr(arguments))) {
             PREP_ERROR(err, ERROR_ARGUMENTS
                        , arguments
                        , "LAMBDA: Not enough arguments."
                        , usage_lambda);
-            return err;
+            break;
           }
           err = make_closure(environment, car(arguments), cdr(arguments), result);
-        } else if (strcmp(operator.value.symbol, "IF") == 0) {
+          break;
+        }
+        case SPECIAL_FORM_IF: {
           const char* usage_if = "Usage: (IF <condition> <then> <else>)";
           if (nilp(arguments) || nilp(cdr(arguments))
               || nilp(cdr(cdr(arguments)))
@@ -593,49 +1311,50 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                          , arguments
                          , "IF: Incorrect number of arguments."
                          , usage_if);
-              return err;
+              break;
             }
-          stack = make_frame(stack, environment, cdr(arguments));
-          list_set(stack, 2, operator);
+          push_frame(environment, cdr(arguments));
+          FRAME.operator = operator;
           expr = car(arguments);
           // Evaluate condition of IF.
           // Result handled in `evaluate_return_value()`
           continue;
-        } else if (strcmp(operator.value.symbol, "WHILE") == 0) {
+        }
+        case SPECIAL_FORM_WHILE: {
           const char* usage_while = "Usage: (WHILE <condition> <body>)";
           if (nilp(arguments) || nilp(cdr(arguments))) {
             PREP_ERROR(err, ERROR_ARGUMENTS
                        , arguments
                        , "WHILE: Not enough arguments!"
                        , usage_while);
-            return err;
+            break;
           }
 #         ifdef LITE_DBG
-          if (env_non_nil(environment, make_sym("DEBUG/WHILE"))) {
+          if (debug_while.value) {
             printf("WHILE: First encounter of ");
             print_atom(cons(operator, arguments));
             putchar('\n');
           }
 #         endif
-          stack = make_frame(stack, environment, arguments);
-          // Stack operator set to WHILE.
-          list_set(stack, 2, operator);
+          push_frame(environment, arguments);
+          FRAME.operator = operator;
           // Evaluate condition of WHILE loop.
           // Result handled in `evaluate_return_value()`
           expr = car(arguments);
           continue;
-        } else if (strcmp(operator.value.symbol, "PROGN") == 0) {
+        }
+        case SPECIAL_FORM_PROGN: {
           if (nilp(arguments)) {
             *result = nil;
           } else {
-            stack = make_frame(stack, environment, arguments);
-            // Stack operator set to PROGN.
-            list_set(stack, 2, operator);
-            // Stack body set to PROGN body.
-            list_set(stack, 5, arguments);
+            push_frame(environment, arguments);
+            FRAME.operator = operator;
+            FRAME.body = arguments;
             // Rest handled in `evaluate_return_value()` and `evaluate_apply()`.
           }
-        } else if (strcmp(operator.value.symbol, "MACRO") == 0) {
+          break;
+        }
+        case SPECIAL_FORM_MACRO: {
           // Arguments: MACRO_NAME ARGUMENTS DOCSTRING BODY
           const char* usage_macro = "Usage: (MACRO <symbol> <argument> <docstring> <body>...)";
           if (nilp(arguments)
@@ -648,7 +1367,7 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                          , arguments
                          , "MACRO: Incorrect number of arguments."
                          , usage_macro);
-              return err;
+              break;
             }
           Atom name = car(arguments);
           if (name.type != ATOM_TYPE_SYMBOL) {
@@ -656,7 +1375,7 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                        , name
                        , "MACRO: The first argument must be a symbol."
                        , usage_macro);
-            return err;
+            break;
           }
           Atom docstring = car(cdr(cdr(arguments)));
           if (docstring.type != ATOM_TYPE_STRING) {
@@ -664,52 +1383,56 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                        , docstring
                        , "MACRO: Docstring must be a string!\n  Strings are text wrapped in double quotes."
                        , usage_macro);
-            return err;
+            break;
           }
           Atom macro;
           err = make_closure(environment
                              , car(cdr(arguments))
                              , cdr(cdr(cdr(arguments)))
                              , &macro);
-          if (err.type) { return err; }
+          if (err.type) { break; }
           macro.type = ATOM_TYPE_MACRO;
-          macro.docstring = strdup(docstring.value.symbol);
-          gcol_generic_allocation(&macro, macro.docstring);
+          symbol_set_docstring(name, docstring.value.symbol);
           (void)env_set(environment, name, macro);
           *result = name;
-        } else if (strcmp(operator.value.symbol, "EVALUATE") == 0) {
+          break;
+        }
+        case SPECIAL_FORM_EVALUATE: {
           const char *usage_evaluate = "Usage: (EVALUATE <expression>)";
           if (nilp(arguments) || !nilp(cdr(arguments))) {
             PREP_ERROR(err, ERROR_ARGUMENTS
                        , arguments
                        , "EVALUATE: Only a single expression is accepted."
                        , usage_evaluate);
-            return err;
+            break;
           }
-          stack = make_frame(stack, environment, nil);
-          list_set(stack, 2, operator);
-          list_set(stack, 4, arguments);
+          push_frame(environment, nil);
+          FRAME.operator = operator;
+          FRAME.evaluated_arguments = arguments;
           // Evaluate expression, result handled in evaluate_return_value().
           expr = car(arguments);
           continue;
-        } else if (strcmp(operator.value.symbol, "ENV") == 0) {
+        }
+        case SPECIAL_FORM_ENV: {
           const char *usage_env = "Usage: (ENV)";
           if (!nilp(arguments)) {
             PREP_ERROR(err, ERROR_ARGUMENTS
                        , arguments
                        , "ENV: Too many arguments! Zero arguments are accepted."
                        , usage_env);
-            return err;
+            break;
           }
           *result = environment;
-        } else if (strcmp(operator.value.symbol, "ERROR") == 0) {
+          break;
+        }
+        case SPECIAL_FORM_ERROR: {
           const char *usage_error = "Usage: (ERROR \"message\")";
           if (nilp(arguments) || !nilp(cdr(arguments))) {
             PREP_ERROR(err, ERROR_ARGUMENTS
                        , arguments
                        , "ERROR: Only a single string argument is accepted."
                        , usage_error);
-            return err;
+            break;
           }
           Atom message = car(arguments);
           if (!stringp(message)) {
@@ -717,12 +1440,15 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                        , arguments
                        , "ERROR: Only a single *string* argument is accepted."
                        , usage_error);
-            return err;
+            break;
           }
           fprintf(stderr, "LISP ERROR: %s\n", message.value.symbol);
           *result = make_string(message.value.symbol);
+          // Stop evaluating entirely, not just this expression.
+          frames_count = base;
           break;
-        } else if (strcmp(operator.value.symbol, "QUIT-COMPLETELY") == 0) {
+        }
+        case SPECIAL_FORM_QUIT_COMPLETELY: {
           const char *usage_error = "Usage: (QUIT-COMPLETELY status)";
           Atom status = nil;
           if (pairp(arguments)) {
@@ -732,7 +1458,7 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
                          , arguments
                          , "ERROR: Only a single *integer* argument is accepted."
                          , usage_error);
-              return err;
+              break;
             }
           } else {
             status = make_int(0);
@@ -740,22 +1466,26 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
           printf("LISP QUIT: STATUS %zu\n", status.value.integer);
           exit((int)status.value.integer);
           break;
-        } else if (strcmp(operator.value.symbol, "OR") == 0) {
-          stack = make_frame(stack, environment, arguments);
-          list_set(stack, 2, operator);
+        }
+        case SPECIAL_FORM_OR: {
+          push_frame(environment, arguments);
+          FRAME.operator = operator;
           expr = car(arguments);
           continue;
-        } else if (strcmp(operator.value.symbol, "AND") == 0) {
-          stack = make_frame(stack, environment, arguments);
-          list_set(stack, 2, operator);
+        }
+        case SPECIAL_FORM_AND: {
+          push_frame(environment, arguments);
+          FRAME.operator = operator;
           expr = car(arguments);
           continue;
-        } else {
+        }
+        default:
           // Evaluate operator before application.
           // *Not* setting the stack operator here is on purpose; it
           // means that evaluate_return_value will understand that the
           // return value it has is actually the operator.
-          stack = make_frame(stack, environment, arguments);
+          push_frame(environment, arguments);
+          FRAME.form = expr;
           expr = operator;
           continue;
         }
@@ -764,45 +1494,35 @@ Error evaluate_expression(Atom expr, Atom environment, Atom *result) {
         //printf("expr: ");pretty_print_atom(expr);putchar('\n');
 
         // Builtins that require access to the environment get it added here.
-        if (operator.value.builtin.function == builtin_docstring) {
+        if (operator.value.builtin->function == builtin_docstring) {
           arguments = cons(environment, arguments);
         }
 
-        char needs_explicit =
-          operator.value.builtin.function == builtin_apply
-          || operator.value.builtin.function == builtin_evaluate_file
-          || operator.value.builtin.function == builtin_evaluate_string
-          || operator.value.builtin.function == builtin_read_prompted;
-        size_t mark = 0;
-        if (needs_explicit) {
-          mark = gcol_explicit_frame();
-          FOR_ALL_GCOL_THINGS(gcol_mark_explicit);
-        }
-        err = (*operator.value.builtin.function)(arguments, result);
-        if (needs_explicit) {
-          UNMARK_ALL_GCOL_THINGS(mark);
-        }
+        // Builtins that evaluate more LISP (i.e. APPLY) may collect
+        // garbage; the arguments stay reachable through EXPR, which is
+        // a registered root, just like RESULT and ENVIRONMENT.
+        err = (*operator.value.builtin->function)(arguments, result);
         if (err.type) {
           if (err.type == ERROR_ARGUMENTS) {
             err.ref = cons(operator, arguments);
           }
-          return err;
+          break;
         }
       } else {
         // Evaluate operator before application.
-        stack = make_frame(stack, environment, arguments);
+        push_frame(environment, arguments);
         expr = operator;
         continue;
       }
     }
-    if (nilp(stack)) {
+    if (frames_count == base) {
       break;
     }
     if (!err.type) {
-      err = evaluate_return_value(&stack, &expr, &environment, result);
+      err = evaluate_return_value(base, &expr, &environment, result);
     }
   } while (!err.type);
+  frames_count = base;
+  gcol_root_pop(3);
   return err;
-#undef FOR_ALL_GCOL_THINGS
-#undef UNMARK_ALL_GCOL_THINGS
 }
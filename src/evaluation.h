@@ -1,9 +1,113 @@
 #ifndef LITE_EVALUATION_H
 #define LITE_EVALUATION_H
 
+#include <environment.h>
 #include <error.h>
 #include <types.h>
 
+/// The special forms, which are evaluated by the evaluator itself
+/// rather than by looking up and applying their operator.
+typedef enum SpecialForm {
+  SPECIAL_FORM_NONE = 0,
+  SPECIAL_FORM_QUOTE,
+  SPECIAL_FORM_QUASIQUOTE,
+  SPECIAL_FORM_DEFINE,
+  SPECIAL_FORM_SET,
+  SPECIAL_FORM_LAMBDA,
+  SPECIAL_FORM_IF,
+  SPECIAL_FORM_WHILE,
+  /// Not valid in source, only ever the operator of a stack frame.
+  SPECIAL_FORM_WHILE_BODY,
+  SPECIAL_FORM_PROGN,
+  SPECIAL_FORM_MACRO,
+  SPECIAL_FORM_EVALUATE,
+  SPECIAL_FORM_ENV,
+  SPECIAL_FORM_ERROR,
+  SPECIAL_FORM_QUIT_COMPLETELY,
+  SPECIAL_FORM_OR,
+  SPECIAL_FORM_AND,
+  SPECIAL_FORM_COUNT
+} SpecialForm;
+
+/** Get the special form named by ATOM, if any.
+ *
+ * Special form symbols are interned the first time this is called,
+ * after which this is a lookup of the symbol's (interned) name
+ * pointer; no strings are compared.
+ *
+ * @return SPECIAL_FORM_NONE unless ATOM is a symbol naming a special form.
+ */
+SpecialForm special_form(Atom atom);
+
 Error evaluate_expression(Atom expr, Atom environment, Atom *result);
 
+/** Evaluate EXPR like evaluate_expression(), allocating pairs into a
+ *  region that is collected as soon as evaluation is finished.
+ *
+ * Meant for short evaluations that leave behind almost nothing but
+ * garbage, like that of a keybinding. Pairs that are still in use
+ * afterwards (i.e. RESULT, or anything written into an older pair or
+ * environment) are kept where they are, and become old; the rest of
+ * the region is given back right away, instead of filling the heap
+ * until the next collection.
+ */
+Error evaluate_expression_transient(Atom expr, Atom environment, Atom *result);
+
+/** Expand the application of MACRO to the unevaluated ARGUMENTS.
+ *
+ * The body of the macro is evaluated by the interpreter, but the
+ * expansion it returns is not evaluated at all.
+ */
+Error evaluate_macro_expand(Atom macro, Atom arguments, Atom *expansion);
+
+/** Expand the QUASIQUOTE of TEMPLATE into the code that builds it.
+ *
+ * `(UNQUOTE x)` within TEMPLATE becomes X, `(UNQUOTE-SPLICING x)`
+ * becomes an APPEND of X, and everything else is consed together. Any
+ * part of TEMPLATE that contains neither becomes a single COPY of it,
+ * so the value built is always fresh, and may be modified.
+ */
+Error evaluate_quasiquote_expand(Atom template, Atom *expansion);
+
+/** Get the closure that `(APPLY FUNCTION ARGUMENTS)` would call, if any.
+ *
+ * This lets APPLY of a closure be carried on with by whatever is
+ * evaluating it, instead of recursing through builtin_apply().
+ *
+ * @return Non-zero iff CLOSURE was set. Anything else, including
+ *         anything APPLY would report an error for, is left to
+ *         builtin_apply().
+ */
+int evaluate_apply_target(Atom function, Atom arguments, Atom *closure);
+
+/** Count a single step of evaluation, and collect garbage if either
+ *  of the garbage collector thresholds has been reached.
+ *
+ * Registered roots (see gcol_root_push()), the global environment, the
+ * buffer table, and everything held by the bytecode virtual machine
+ * are marked before collecting.
+ */
+void evaluation_gcol_step(void);
+
+/** Get on with the garbage collection in progress, if any, for as long
+ *  as GARBAGE-COLLECTOR-PAUSE-BUDGET allows.
+ *
+ * Major collections are marked a little at a time in between
+ * evaluation iterations; when there's time to spare (i.e. waiting on
+ * input), this gets them over with sooner.
+ */
+void evaluation_gcol_idle(void);
+
+/** Return an association list of statistics about garbage collection
+ *  so far, as returned by GARBAGE-COLLECTOR-STATISTICS.
+ */
+Atom evaluation_gcol_statistics(void);
+
+/// WHILE-RECURSE-LIMIT, the most times any WHILE loop may loop.
+extern WatchedVariable while_recurse_limit;
+
+/// Register the global variables the evaluator reads from C with
+/// env_watch(), bringing them up to date with the global environment.
+void evaluation_watch_variables(void);
+
 #endif /* LITE_EVALUATION_H */
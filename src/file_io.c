@@ -205,7 +205,7 @@ Error evaluate_file(Atom environment, const char *path, Atom *result) {
   }
 
 # ifdef LITE_DBG
-  env_get(*genv(), make_sym("DEBUG/MEMORY"), &debug_memory);
+  env_get(*genv(), SYM(DEBUG_MEMORY), &debug_memory);
   if (!nilp(debug_memory)) {
     printf("%s:\n"
            "  allocated: %20zu\n"
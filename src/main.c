@@ -84,6 +84,8 @@ int main(int argc, char **argv) {
   Atom result = nil;
   handle_arguments(argc, argv);
 
+  symbols_initialize();
+
   Atom initial_buffer;
 
   initial_buffer = nil;
@@ -98,11 +100,11 @@ int main(int argc, char **argv) {
       return 1;
     }
   }
-  env_set(*genv(), make_sym("CURRENT-BUFFER"), initial_buffer);
+  env_set(*genv(), SYM(CURRENT_BUFFER), initial_buffer);
 
 # ifdef LITE_GFX
   Atom popup_buffer = make_buffer(env_create(nil, 0), ".popup");
-  env_set(*genv(), make_sym("POPUP-BUFFER"), popup_buffer);
+  env_set(*genv(), SYM(POPUP_BUFFER), popup_buffer);
 
   // Only initialize GUI if script mode is NOT active, as if it is, we
   // won't be launching into the GUI.
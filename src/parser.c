@@ -65,8 +65,6 @@ Error parse_simple(const char *beg, const char *end, Atom *result) {
   if (p == end) {
     result->type = ATOM_TYPE_INTEGER;
     result->value.integer = value;
-    result->docstring = NULL;
-    result->galloc = NULL;
     return ok;
   }
   // NIL or SYMBOL
@@ -293,11 +291,11 @@ Error parse_expr(const char *source, const char **end, Atom *result) {
       if (!list) { return ok; }
       break;
     case '\'':
-      *working_result = cons(make_sym("QUOTE"), cons(nil, nil));
+      *working_result = cons(SYM(QUOTE), cons(nil, nil));
       working_result = &car(cdr(*working_result));
       continue;
     case '`':
-      *working_result = cons(make_sym("QUASIQUOTE"), cons(nil, nil));
+      *working_result = cons(SYM(QUASIQUOTE), cons(nil, nil));
       working_result = &car(cdr(*working_result));
       continue;
     case ',':
@@ -174,10 +174,6 @@ Rope *rope_insert(Rope *rope, size_t index, char *str) {
   if (contents_length == 1) {
     return rope_insert_byte(rope, index, str[0]);
   }
-  char *contents = malloc(contents_length > 0 ? contents_length + 1 : 8);
-  if (!contents) { return NULL; }
-  memcpy(contents, str, contents_length);
-  contents[contents_length] = '\0';
   if (index >= rope->weight) {
     return rope_append(rope, str);
   } else {
@@ -242,23 +238,33 @@ Rope *rope_insert(Rope *rope, size_t index, char *str) {
      * new_left_left (1)  new_contents (13)
      */
 
+    // Only copied here, as appending and prepending copy it themselves.
+    char *contents = malloc(contents_length + 1);
+    if (!contents) { return NULL; }
+    memcpy(contents, str, contents_length);
+    contents[contents_length] = '\0';
+
     Rope *new_left_left = malloc(sizeof(Rope));
     if (!new_left_left) {
+      free(contents);
       return NULL;
     }
     Rope *new_left = malloc(sizeof(Rope));
     if (!new_left) {
+      free(contents);
       free(new_left_left);
       return NULL;
     }
     Rope *new_contents = malloc(sizeof(Rope));
     if (!new_contents) {
+      free(contents);
       free(new_left_left);
       free(new_left);
       return NULL;
     }
     Rope *new_right = malloc(sizeof(Rope));
     if (!new_right) {
+      free(contents);
       free(new_left_left);
       free(new_left);
       free(new_contents);
@@ -12,249 +12,1039 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#ifdef LITE_GCOL_THREADS
+#  include <pthread.h>
+#  include <sched.h>
+#endif /* #ifdef LITE_GCOL_THREADS */
+
+#ifdef _WIN32
+#  include <malloc.h>
+#endif /* #ifdef _WIN32 */
 
 bool strict_output = false;
 
-static Atom buffer_table = { ATOM_TYPE_NIL, { 0 }, NULL, NULL };
+static Atom buffer_table = { ATOM_TYPE_NIL, { 0 } };
 Atom *buf_table() { return &buffer_table; }
 
 //================================================================ BEG garbage_collection
 
-ConsAllocation *global_pair_allocations = NULL;
 size_t pair_allocations_count = 0;
 size_t pair_allocations_freed = 0;
 
-GenericAllocation *generic_allocations = NULL;
+/// A pair that isn't in use is on the free list of it's page.
+typedef union ConsCell {
+  Pair pair;
+  union ConsCell *next_free;
+} ConsCell;
+
+/// Pages are aligned to their size, so the page any pair is within is
+/// found by clearing the low bits of it's address.
+#define CONS_PAGE_SIZE ((size_t)1 << 16)
+/// Enough is left over for the rest of a ConsPage.
+#define CONS_PAGE_CELLS ((CONS_PAGE_SIZE - 64) / (sizeof(ConsCell) + sizeof(unsigned char)))
+
+typedef struct ConsPage {
+  struct ConsPage *next;
+  /// Cells that have been in use, and since been swept.
+  ConsCell *free;
+  /// Cells from this index on have never been handed out.
+  size_t bump;
+  /// Cells currently in use (as of the last sweep).
+  size_t used;
+  unsigned char marks[CONS_PAGE_CELLS];
+  ConsCell cells[CONS_PAGE_CELLS];
+} ConsPage;
+
+static_assert(sizeof(ConsPage) <= CONS_PAGE_SIZE, "ConsPage must fit within CONS_PAGE_SIZE");
+
+static ConsPage *cons_pages = NULL;
+static ConsPage *cons_pages_last = NULL;
+/// The page pairs are being allocated from; every page before it has
+/// nothing left to hand out until the next sweep.
+static ConsPage *cons_page_current = NULL;
+
+static ConsPage *cons_page_of(Pair *pair) {
+  return (ConsPage *)((uintptr_t)pair & ~(uintptr_t)(CONS_PAGE_SIZE - 1));
+}
+
+static unsigned char *cons_mark(Pair *pair) {
+  ConsPage *page = cons_page_of(pair);
+  return page->marks + ((ConsCell *)pair - page->cells);
+}
+
+static ConsPage *cons_page_create(void) {
+  void *memory = NULL;
+# ifdef _WIN32
+  memory = _aligned_malloc(CONS_PAGE_SIZE, CONS_PAGE_SIZE);
+# else
+  if (posix_memalign(&memory, CONS_PAGE_SIZE, CONS_PAGE_SIZE)) {
+    memory = NULL;
+  }
+# endif
+  if (!memory) { return NULL; }
+  ConsPage *page = memory;
+  page->next = NULL;
+  page->free = NULL;
+  page->bump = 0;
+  page->used = 0;
+  memset(page->marks, 0, sizeof page->marks);
+  return page;
+}
+
+static void cons_page_free(ConsPage *page) {
+# ifdef _WIN32
+  _aligned_free(page);
+# else
+  free(page);
+# endif
+}
+
+/// Whether pairs are being allocated into a region (see
+/// gcol_region_begin()).
+static char cons_region = 0;
+/// Pages of the region in progress, only ever allocated from the last.
+static ConsPage *cons_region_pages = NULL;
+static ConsPage *cons_region_last = NULL;
+
+/// Return a pair from the region in progress, or NULL if out of memory.
+static Pair *cons_region_allocate(void) {
+  ConsPage *page = cons_region_last;
+  if (!page || page->bump >= CONS_PAGE_CELLS) {
+    page = cons_page_create();
+    if (!page) { return NULL; }
+    if (cons_region_last) {
+      cons_region_last->next = page;
+    } else {
+      cons_region_pages = page;
+    }
+    cons_region_last = page;
+  }
+  page->used += 1;
+  return &page->cells[page->bump++].pair;
+}
+
+/** Move pages of the region in progress to the start of the heap.
+ *
+ * Pages at the start are always swept by a minor collection, so pairs
+ * allocated into a region are collected like any others from then on.
+ */
+static void cons_region_splice(void) {
+  if (!cons_region_pages) { return; }
+  cons_region_last->next = cons_pages;
+  if (!cons_pages_last) {
+    cons_pages_last = cons_region_last;
+  }
+  if (!cons_page_current) {
+    cons_page_current = cons_region_pages;
+  }
+  cons_pages = cons_region_pages;
+  cons_region_pages = NULL;
+  cons_region_last = NULL;
+}
+
+/// Return a pair that isn't in use, or NULL if out of memory.
+static Pair *cons_pair_allocate(void) {
+  if (cons_region) {
+    return cons_region_allocate();
+  }
+  ConsPage *page = cons_page_current;
+  while (page) {
+    if (page->free) {
+      ConsCell *cell = page->free;
+      page->free = cell->next_free;
+      page->used += 1;
+      return &cell->pair;
+    }
+    if (page->bump < CONS_PAGE_CELLS) {
+      page->used += 1;
+      return &page->cells[page->bump++].pair;
+    }
+    page = page->next;
+    cons_page_current = page;
+  }
+  page = cons_page_create();
+  if (!page) { return NULL; }
+  if (cons_pages_last) {
+    cons_pages_last->next = page;
+  } else {
+    cons_pages = page;
+  }
+  cons_pages_last = page;
+  cons_page_current = page;
+  page->used = 1;
+  return &page->cells[page->bump++].pair;
+}
+
 size_t generic_allocations_count = 0;
 size_t generic_allocations_freed = 0;
 
-Error gcol_generic_allocation(Atom *ref, void *payload) {
-  if (!ref) {
-    MAKE_ERROR(err, ERROR_ARGUMENTS, nil,
-               "GALLOC: Can not allocate when NULL referring Atom is passed."
-               , NULL);
-      return err;
+/// Largest payload of each size class, in bytes. Size class zero is
+/// for payloads allocated elsewhere, that only the generic allocation
+/// itself is needed for.
+static const size_t galloc_class_sizes[] = {
+  0, 16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024
+};
+#define GALLOC_CLASS_COUNT (sizeof galloc_class_sizes / sizeof *galloc_class_sizes)
+#define GALLOC_PAGE_SIZE ((size_t)1 << 16)
+
+/// Blocks are a generic allocation followed directly by it's payload.
+typedef struct GallocPage {
+  struct GallocPage *next;
+  /// Blocks that have been in use, and since been swept.
+  GenericAllocation *free;
+  size_t block_size;
+  size_t block_count;
+  /// Blocks from this index on have never been handed out.
+  size_t bump;
+  size_t blocks[];
+} GallocPage;
+
+typedef struct GallocClass {
+  GallocPage *pages;
+  GallocPage *last;
+  /// The page blocks are being allocated from; every page before it
+  /// has nothing left to hand out until the next sweep.
+  GallocPage *current;
+} GallocClass;
+
+static GallocClass galloc_classes[GALLOC_CLASS_COUNT];
+
+/// Allocations with payloads too large for any size class, newest
+/// first.
+static GenericAllocation *galloc_large = NULL;
+/// The newest large allocation that has survived a collection; all
+/// before it in the list are young.
+static GenericAllocation *galloc_large_old = NULL;
+
+/// The generic allocation that PAYLOAD, as returned by gcol_allocate(),
+/// is the payload of.
+#define galloc_of(payload) ((GenericAllocation *)(payload) - 1)
+
+static GenericAllocation *galloc_block(GallocPage *page, size_t index) {
+  return (GenericAllocation *)((char *)page->blocks + index * page->block_size);
+}
+
+static GallocPage *galloc_page_create(size_t class) {
+  GallocPage *page = malloc(GALLOC_PAGE_SIZE);
+  if (!page) { return NULL; }
+  page->next = NULL;
+  page->free = NULL;
+  page->block_size = sizeof(GenericAllocation) + galloc_class_sizes[class];
+  page->block_count = (GALLOC_PAGE_SIZE - sizeof(GallocPage)) / page->block_size;
+  page->bump = 0;
+  return page;
+}
+
+/// Return a block of the given size class that isn't in use, or NULL
+/// if out of memory.
+static GenericAllocation *galloc_block_allocate(size_t class) {
+  GallocClass *galloc_class = galloc_classes + class;
+  GallocPage *page = galloc_class->current;
+  while (page) {
+    if (page->free) {
+      GenericAllocation *block = page->free;
+      page->free = block->next;
+      return block;
+    }
+    if (page->bump < page->block_count) {
+      return galloc_block(page, page->bump++);
+    }
+    page = page->next;
+    galloc_class->current = page;
+  }
+  page = galloc_page_create(class);
+  if (!page) { return NULL; }
+  if (galloc_class->last) {
+    galloc_class->last->next = page;
+  } else {
+    galloc_class->pages = page;
+  }
+  galloc_class->last = page;
+  galloc_class->current = page;
+  return galloc_block(page, page->bump++);
+}
+
+/// Return a generic allocation with room for SIZE bytes of payload
+/// directly after it, or NULL if out of memory.
+static GenericAllocation *galloc_create(size_t size) {
+  GenericAllocation *galloc = NULL;
+  size_t class = 0;
+  while (class < GALLOC_CLASS_COUNT && galloc_class_sizes[class] < size) {
+    ++class;
+  }
+  if (class < GALLOC_CLASS_COUNT) {
+    galloc = galloc_block_allocate(class);
+    if (!galloc) { return NULL; }
+  } else {
+    galloc = malloc(sizeof(GenericAllocation) + size);
+    if (!galloc) { return NULL; }
+    galloc->next = galloc_large;
+    galloc_large = galloc;
+  }
+  galloc->payload = galloc + 1;
+  galloc->finalize = NULL;
+  galloc->mark = 0;
+  generic_allocations_count += 1;
+  return galloc;
+}
+
+/// Free the payload of GALLOC, and mark it as no longer in use.
+static void galloc_finalize(GenericAllocation *galloc) {
+  if (galloc->finalize) {
+    galloc->finalize(galloc->payload);
   }
-  if (!payload) {
-    MAKE_ERROR(err, ERROR_ARGUMENTS, *ref
-               , "GALLOC: Can not allocate NULL payload."
-               , NULL);
-    return err;
+  galloc->payload = NULL;
+  generic_allocations_freed += 1;
+}
+
+void *gcol_allocate(size_t size, GenericFinalizer finalize) {
+  GenericAllocation *galloc = galloc_create(size);
+  if (!galloc) { return NULL; }
+  galloc->finalize = finalize;
+  return galloc->payload;
+}
+
+/// Any type made with `cons()`.
+#define cons_made(a) (pairp(a) || closurep(a) || macrop(a))
+
+/// Return the generic allocation ATOM points to, or NULL if none.
+static GenericAllocation *atom_galloc(Atom atom) {
+  switch (atom.type) {
+  default:
+    return NULL;
+  case ATOM_TYPE_STRING:
+    return galloc_of(atom.value.symbol);
+  case ATOM_TYPE_ENVIRONMENT:
+    return galloc_of(atom.value.env);
+  case ATOM_TYPE_BUFFER:
+    return galloc_of(atom.value.buffer);
   }
-  GenericAllocation *galloc = calloc(1, sizeof(GenericAllocation));
-  if (!galloc) {
-    MAKE_ERROR(err, ERROR_MEMORY, *ref
-               , "GALLOC: Could not allocate memory for generic allocation."
-               , NULL);
-    return err;
+}
+
+/// Whether the collection in progress is major (see gcol_start()).
+static char gcol_major = 1;
+
+/// Whether a major collection is being marked incrementally.
+static char gcol_marking = 0;
+
+/// Whether the collection in progress only sweeps the pages of a
+/// region (see gcol_start_region()).
+static char gcol_region_collection = 0;
+
+#ifdef LITE_GCOL_THREADS
+/// Whether marking is spread across threads right now, so that marks
+/// must be claimed atomically.
+static char gcol_parallel = 0;
+#  define gcol_mark_load(mark) __atomic_load_n((mark), __ATOMIC_RELAXED)
+#  define gcol_mark_store(mark) __atomic_store_n((mark), 1, __ATOMIC_RELAXED)
+#else
+#  define gcol_mark_load(mark) (*(mark))
+#  define gcol_mark_store(mark) (*(mark) = 1)
+#endif /* #ifdef LITE_GCOL_THREADS */
+
+/// Set MARK, returning non-zero iff it wasn't already set (by any
+/// thread).
+static int gcol_claim(unsigned char *mark) {
+  if (gcol_mark_load(mark)) {
+    return 0;
+  }
+# ifdef LITE_GCOL_THREADS
+  if (gcol_parallel) {
+    return __atomic_exchange_n(mark, 1, __ATOMIC_RELAXED) == 0;
   }
+# endif
+  *mark = 1;
+  return 1;
+}
 
-  galloc->payload = payload;
+typedef struct GcolStack {
+  Atom *items;
+  size_t count;
+  size_t capacity;
+  /// What has been marked while marking with this stack, during a
+  /// major collection.
+  GcolCensus census;
+} GcolStack;
+
+/// Make room for at least COUNT more atoms on STACK.
+static void gcol_stack_reserve(GcolStack *stack, size_t count) {
+  if (stack->count + count <= stack->capacity) {
+    return;
+  }
+  size_t new_capacity = stack->capacity ? stack->capacity : 1024;
+  while (new_capacity < stack->count + count) {
+    new_capacity *= 2;
+  }
+  Atom *new_items = realloc(stack->items, new_capacity * sizeof(Atom));
+  if (!new_items) {
+    fprintf(stderr, "GCOL: Could not allocate memory for mark stack.\n");
+    exit(1);
+  }
+  stack->items = new_items;
+  stack->capacity = new_capacity;
+}
 
-  galloc->next = generic_allocations;
-  generic_allocations = galloc;
-  generic_allocations_count += 1;
+static void gcol_stack_push(GcolStack *stack, Atom atom) {
+  gcol_stack_reserve(stack, 1);
+  stack->items[stack->count++] = atom;
+}
 
-  galloc->ref = *ref;
+/// Marked pairs, environments and buffers that have yet to be marked
+/// through.
+/// Incremental marking leaves them here in between slices, so
+/// gcol_mark() only ever pops what it has pushed itself.
+static GcolStack gcol_gray = { NULL, 0, 0, { { 0 }, { 0 } } };
 
-  galloc->more = ref->galloc;
-  ref->galloc = galloc;
+/// What was marked by the last major collection to finish.
+static GcolCensus gcol_census_last = { { 0 }, { 0 } };
 
-  return ok;
+const GcolCensus *gcol_census(void) {
+  return &gcol_census_last;
 }
 
-void gcol_mark(Atom *root) {
+/// Count ROOT, which has just been marked, in CENSUS.
+static void gcol_census_count(GcolCensus *census, Atom *root) {
+  size_t bytes = 0;
+  switch (root->type) {
+  default:
+    break;
+  case ATOM_TYPE_PAIR:
+  case ATOM_TYPE_CLOSURE:
+  case ATOM_TYPE_MACRO:
+    bytes = sizeof(Pair);
+    break;
+  case ATOM_TYPE_STRING:
+    bytes = strlen(root->value.symbol) + 1;
+    break;
+  case ATOM_TYPE_ENVIRONMENT:
+    bytes = sizeof(Environment) + root->value.env->data_capacity * sizeof(EnvironmentValue);
+    break;
+  case ATOM_TYPE_BUFFER:
+    bytes = sizeof(Buffer) + buffer_size(*root->value.buffer);
+    break;
+  }
+  census->objects[root->type] += 1;
+  census->bytes[root->type] += bytes;
+}
+
+/// Mark the allocations of ROOT itself as in-use, counting it in the
+/// census of STACK. Return non-zero iff it has just been marked, and
+/// what it holds has yet to be.
+static int gcol_mark_one(GcolStack *stack, Atom *root) {
   if (nilp(*root)) {
-    return;
+    return 0;
   }
-  if (root->galloc) {
-    GenericAllocation *galloc = root->galloc;
-    while (galloc) {
-      galloc->mark = 1;
-      galloc = galloc->more;
+  GenericAllocation *galloc = atom_galloc(*root);
+  if (galloc) {
+    int claimed = gcol_claim(&galloc->mark);
+    if (envp(*root) || bufferp(*root)) {
+      // Once the generic allocation of an environment or a buffer is
+      // marked, so is everything it holds.
+      if (!claimed) {
+        return 0;
+      }
+      if (gcol_major) {
+        gcol_census_count(&stack->census, root);
+      }
+    } else if (claimed && gcol_major) {
+      gcol_census_count(&stack->census, root);
     }
   }
-  // Any type made with `cons()` belongs here.
-  if (pairp(*root) || closurep(*root) || macrop(*root)) {
-    ConsAllocation *alloc = (ConsAllocation *)
-      ((char *)root->value.pair - offsetof(ConsAllocation, pair));
-    if (!alloc || alloc->mark == 1) { return; }
-    alloc->mark = 1;
-    gcol_mark(&car(*root));
-    gcol_mark(&cdr(*root));
+  if (cons_made(*root)) {
+    if (!gcol_claim(cons_mark(root->value.pair))) {
+      return 0;
+    }
+    if (gcol_major) {
+      gcol_census_count(&stack->census, root);
+    }
+    return 1;
   }
-  if (envp(*root)) {
-    size_t index = 0;
-    EnvironmentValue *entry;
-    while (index < root->value.env->data_capacity) {
-      entry = root->value.env->data + index;
-      if (entry->key) {
-        gcol_mark(&entry->value);
+  return envp(*root) || bufferp(*root);
+}
+
+/** Mark everything held by ATOM, which has just been marked itself.
+ *
+ * The cdr of a pair, and the parent of an environment, is returned to
+ * be walked on to directly rather than pushed, so a list or a chain of
+ * parents takes no room on the stack however long it is, and the pairs
+ * of a list are visited in the order they are linked. Everything else
+ * that has yet to be marked through is pushed on to STACK.
+ *
+ * @return What to mark through next, or nil.
+ */
+static Atom gcol_mark_through(GcolStack *stack, Atom atom) {
+  if (envp(atom)) {
+    Environment *env = atom.value.env;
+    for (size_t index = 0; index < env->data_capacity; ++index) {
+      EnvironmentValue *entry = env->data + index;
+      if (entry->key && gcol_mark_one(stack, &entry->value)) {
+        gcol_stack_push(stack, entry->value);
       }
-      ++index;
     }
-    if (envp(root->value.env->parent)) {
-      gcol_mark(&root->value.env->parent);
+    if (gcol_mark_one(stack, &env->parameters)) {
+      gcol_stack_push(stack, env->parameters);
     }
+    return gcol_mark_one(stack, &env->parent) ? env->parent : nil;
+  }
+  if (bufferp(atom)) {
+    Buffer *buffer = atom.value.buffer;
+    return gcol_mark_one(stack, &buffer->environment) ? buffer->environment : nil;
   }
+  if (gcol_mark_one(stack, &car(atom))) {
+    gcol_stack_push(stack, car(atom));
+  }
+  return gcol_mark_one(stack, &cdr(atom)) ? cdr(atom) : nil;
 }
 
-static size_t mark = 1;
-size_t gcol_explicit_frame(void) {
-  if (mark == SIZE_MAX) mark = 1;
-  return ++mark;
+/** Mark through everything reachable from the atoms on the gray stack
+ *  above BASE, until either nothing is left above BASE or BUDGET
+ *  microseconds of processor time have passed (never, if negative).
+ *
+ * @return Non-zero iff nothing is left above BASE.
+ */
+static int gcol_mark_gray_above(size_t base, integer_t budget) {
+  clock_t deadline = 0;
+  if (budget >= 0) {
+    deadline = clock() + (clock_t)(budget * CLOCKS_PER_SEC / 1000000);
+  }
+  size_t work = 0;
+  Atom atom = nil;
+  while (!nilp(atom) || gcol_gray.count > base) {
+    if (nilp(atom)) {
+      atom = gcol_gray.items[--gcol_gray.count];
+    }
+    // Checking the time isn't free either.
+    if (budget >= 0 && ++work % 64 == 0 && clock() >= deadline) {
+      gcol_stack_push(&gcol_gray, atom);
+      return 0;
+    }
+    atom = gcol_mark_through(&gcol_gray, atom);
+  }
+  return 1;
 }
 
-void gcol_mark_explicit(Atom *root) {
-  if (nilp(*root)) {
+void gcol_mark(Atom *root) {
+  size_t base = gcol_gray.count;
+  if (gcol_mark_one(&gcol_gray, root)) {
+    gcol_stack_push(&gcol_gray, *root);
+    gcol_mark_gray_above(base, -1);
+  }
+}
+
+static Atom **gcol_roots = NULL;
+static size_t gcol_roots_count = 0;
+static size_t gcol_roots_capacity = 0;
+
+void gcol_root_push(Atom *root) {
+  if (gcol_roots_count >= gcol_roots_capacity) {
+    size_t new_capacity = gcol_roots_capacity ? gcol_roots_capacity * 2 : 256;
+    Atom **new_roots = realloc(gcol_roots, new_capacity * sizeof(Atom *));
+    if (!new_roots) {
+      fprintf(stderr, "GCOL: Could not allocate memory for new garbage collection root.\n");
+      exit(1);
+    }
+    gcol_roots = new_roots;
+    gcol_roots_capacity = new_capacity;
+  }
+  gcol_roots[gcol_roots_count++] = root;
+}
+
+void gcol_root_pop(size_t count) {
+  assert(count <= gcol_roots_count && "gcol_root_pop(): More roots popped than pushed.");
+  gcol_roots_count -= count;
+}
+
+void gcol_shade_roots(void) {
+  for (size_t i = 0; i < gcol_roots_count; ++i) {
+    gcol_shade(gcol_roots[i]);
+  }
+}
+
+int gcol_marked(Atom root) {
+  if (!cons_made(root)) {
+    return 0;
+  }
+  return *cons_mark(root.value.pair) != 0;
+}
+
+/// Old pairs and environments written into since the previous
+/// collection, that may refer to young allocations.
+static Atom *gcol_remembered = NULL;
+static size_t gcol_remembered_count = 0;
+static size_t gcol_remembered_capacity = 0;
+
+/// Return non-zero iff ATOM refers to anything allocated since the
+/// previous collection.
+static int gcol_young(Atom atom) {
+  GenericAllocation *galloc = atom_galloc(atom);
+  if (galloc && galloc->mark == 0) {
+    return 1;
+  }
+  return cons_made(atom) && *cons_mark(atom.value.pair) == 0;
+}
+
+void gcol_shade(Atom *root) {
+  if (gcol_mark_one(&gcol_gray, root)) {
+    gcol_stack_push(&gcol_gray, *root);
+  }
+}
+
+void gcol_start_incremental(void) {
+  gcol_start(1);
+  gcol_marking = 1;
+}
+
+int gcol_mark_gray(integer_t budget) {
+  return gcol_mark_gray_above(0, budget);
+}
+
+#ifdef LITE_GCOL_THREADS
+
+/* Marking in parallel spreads what is on the gray stack across a pool
+ * of threads, each marking through what it has on a stack of it's
+ * own. Every so often, a thread with plenty left shares the older
+ * half of it's stack, if any other thread has run out; those that
+ * have run out take half of what any thread has shared. Marking is
+ * finished once every thread has run out at once.
+ */
+
+#define GCOL_MARKERS_MAX 64
+
+typedef struct GcolMarker {
+  /// Only ever touched by the thread marking with it. The collecting
+  /// thread marks with the gray stack itself, instead.
+  GcolStack stack;
+  /// Held while SHARED is changed or taken from. Only the thread
+  /// marking with it adds to SHARED, and only once it's empty.
+  pthread_mutex_t lock;
+  GcolStack shared;
+} GcolMarker;
+
+static GcolMarker gcol_markers[GCOL_MARKERS_MAX];
+static char gcol_markers_initialized = 0;
+/// Threads marking in the parallel mark in progress, including the
+/// collecting thread.
+static size_t gcol_markers_count = 0;
+/// Threads that have run out of things to mark through.
+static size_t gcol_markers_idle = 0;
+
+/// Marker threads that have been started; they are never stopped.
+static size_t gcol_threads_count = 0;
+static pthread_mutex_t gcol_threads_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gcol_threads_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t gcol_threads_done = PTHREAD_COND_INITIALIZER;
+/// Bumped each time marker threads are started marking.
+static size_t gcol_threads_epoch = 0;
+/// Marker threads that have yet to finish the parallel mark in
+/// progress.
+static size_t gcol_threads_running = 0;
+
+/// Take half of what VICTIM has shared (at least one, if any) on to
+/// STACK. Return non-zero iff anything was taken.
+static int gcol_marker_steal(GcolMarker *victim, GcolStack *stack) {
+  pthread_mutex_lock(&victim->lock);
+  size_t shared = victim->shared.count;
+  size_t count = (shared + 1) / 2;
+  if (count) {
+    gcol_stack_reserve(stack, count);
+    memcpy(stack->items + stack->count, victim->shared.items + shared - count, count * sizeof(Atom));
+    stack->count += count;
+    __atomic_store_n(&victim->shared.count, shared - count, __ATOMIC_SEQ_CST);
+  }
+  pthread_mutex_unlock(&victim->lock);
+  return count != 0;
+}
+
+/// Share the older half of STACK, if another thread has run out and
+/// nothing is shared already.
+static void gcol_marker_share(GcolMarker *marker, GcolStack *stack) {
+  if (stack->count < 2
+      || !__atomic_load_n(&gcol_markers_idle, __ATOMIC_SEQ_CST)
+      || __atomic_load_n(&marker->shared.count, __ATOMIC_SEQ_CST)) {
     return;
   }
-  if (root->galloc) {
-    GenericAllocation *galloc = root->galloc;
-    while (galloc) {
-      // Overwrite unmarked or regularly marked atoms, but don't
-      // overwrite explicitly marked.
-      if (galloc->mark <= 1) {
-        galloc->mark = mark;
+  size_t count = stack->count / 2;
+  pthread_mutex_lock(&marker->lock);
+  gcol_stack_reserve(&marker->shared, count);
+  memcpy(marker->shared.items, stack->items, count * sizeof(Atom));
+  __atomic_store_n(&marker->shared.count, count, __ATOMIC_SEQ_CST);
+  pthread_mutex_unlock(&marker->lock);
+  stack->count -= count;
+  memmove(stack->items, stack->items + count, stack->count * sizeof(Atom));
+}
+
+/** Take more to mark through on to STACK from what any thread has
+ *  shared, waiting until there is some, or until every thread has run
+ *  out.
+ *
+ * A thread only counts as having run out while it has nothing at all,
+ * so once every thread has, there can't be anything left to mark.
+ *
+ * @return Non-zero iff there is more to mark through.
+ */
+static int gcol_marker_take(size_t index, GcolStack *stack) {
+  if (gcol_marker_steal(gcol_markers + index, stack)) {
+    return 1;
+  }
+  __atomic_add_fetch(&gcol_markers_idle, 1, __ATOMIC_SEQ_CST);
+  for (;;) {
+    if (__atomic_load_n(&gcol_markers_idle, __ATOMIC_SEQ_CST) == gcol_markers_count) {
+      return 0;
+    }
+    for (size_t i = 1; i < gcol_markers_count; ++i) {
+      GcolMarker *victim = gcol_markers + (index + i) % gcol_markers_count;
+      if (!__atomic_load_n(&victim->shared.count, __ATOMIC_SEQ_CST)) {
+        continue;
       }
-      galloc = galloc->more;
+      __atomic_sub_fetch(&gcol_markers_idle, 1, __ATOMIC_SEQ_CST);
+      if (gcol_marker_steal(victim, stack)) {
+        return 1;
+      }
+      __atomic_add_fetch(&gcol_markers_idle, 1, __ATOMIC_SEQ_CST);
     }
+    sched_yield();
   }
-  // Any type made with `cons()` belongs here.
-  if (pairp(*root) || closurep(*root) || macrop(*root)) {
-    ConsAllocation *alloc = (ConsAllocation *)
-      ((char *)root->value.pair - offsetof(ConsAllocation, pair));
-    if (!alloc || alloc->mark > 1) { return; }
-    alloc->mark = mark;
-    gcol_mark_explicit(&car(*root));
-    gcol_mark_explicit(&cdr(*root));
-  }
-  if (envp(*root)) {
-    size_t index = 0;
-    EnvironmentValue *entry;
-    while (index < root->value.env->data_capacity) {
-      entry = root->value.env->data + index;
-      if (entry->key) {
-        gcol_mark_explicit(&entry->value);
+}
+
+/// Mark with the marker at INDEX until every thread has run out.
+static void gcol_marker_run(size_t index) {
+  GcolMarker *marker = gcol_markers + index;
+  GcolStack *stack = index ? &marker->stack : &gcol_gray;
+  size_t work = 0;
+  do {
+    Atom atom = nil;
+    while (!nilp(atom) || stack->count) {
+      if (nilp(atom)) {
+        atom = stack->items[--stack->count];
       }
-      ++index;
+      if (++work % 64 == 0) {
+        gcol_marker_share(marker, stack);
+      }
+      atom = gcol_mark_through(stack, atom);
+    }
+  } while (gcol_marker_take(index, stack));
+}
+
+static void *gcol_marker_thread(void *argument) {
+  size_t index = (size_t)(uintptr_t)argument;
+  size_t epoch = 0;
+  pthread_mutex_lock(&gcol_threads_lock);
+  for (;;) {
+    while (epoch == gcol_threads_epoch) {
+      pthread_cond_wait(&gcol_threads_start, &gcol_threads_lock);
     }
-    // TODO: Use continuation here instead of recursion (replace root).
-    if (envp(root->value.env->parent)) {
-      gcol_mark_explicit(&root->value.env->parent);
+    epoch = gcol_threads_epoch;
+    if (index >= gcol_markers_count) {
+      continue;
+    }
+    pthread_mutex_unlock(&gcol_threads_lock);
+    gcol_marker_run(index);
+    pthread_mutex_lock(&gcol_threads_lock);
+    if (!--gcol_threads_running) {
+      pthread_cond_signal(&gcol_threads_done);
     }
   }
+  return NULL;
 }
 
-void gcol_unmark(Atom *root, size_t mark_num) {
-  if (nilp(*root)) {
+void gcol_mark_gray_parallel(size_t threads) {
+  if (threads > GCOL_MARKERS_MAX) {
+    threads = GCOL_MARKERS_MAX;
+  }
+  if (!gcol_markers_initialized) {
+    for (size_t i = 0; i < GCOL_MARKERS_MAX; ++i) {
+      pthread_mutex_init(&gcol_markers[i].lock, NULL);
+    }
+    gcol_markers_initialized = 1;
+  }
+  while (gcol_threads_count + 1 < threads) {
+    pthread_t thread;
+    void *index = (void *)(uintptr_t)(gcol_threads_count + 1);
+    if (pthread_create(&thread, NULL, gcol_marker_thread, index)) {
+      break;
+    }
+    pthread_detach(thread);
+    gcol_threads_count += 1;
+  }
+  if (threads > gcol_threads_count + 1) {
+    threads = gcol_threads_count + 1;
+  }
+  if (threads < 2) {
+    gcol_mark_gray(-1);
     return;
   }
-  if (root->galloc) {
-    GenericAllocation *galloc = root->galloc;
-    while (galloc) {
-      if (galloc->mark == mark_num) {
-        galloc->mark = 0;
-      }
-      galloc = galloc->more;
+  pthread_mutex_lock(&gcol_threads_lock);
+  gcol_parallel = 1;
+  gcol_markers_count = threads;
+  gcol_markers_idle = 0;
+  gcol_threads_running = threads - 1;
+  gcol_threads_epoch += 1;
+  pthread_cond_broadcast(&gcol_threads_start);
+  pthread_mutex_unlock(&gcol_threads_lock);
+
+  gcol_marker_run(0);
+
+  pthread_mutex_lock(&gcol_threads_lock);
+  while (gcol_threads_running) {
+    pthread_cond_wait(&gcol_threads_done, &gcol_threads_lock);
+  }
+  gcol_parallel = 0;
+  pthread_mutex_unlock(&gcol_threads_lock);
+
+  for (size_t i = 1; i < threads; ++i) {
+    GcolCensus *census = &gcol_markers[i].stack.census;
+    for (size_t type = 0; type < ATOM_TYPE_MAX; ++type) {
+      gcol_gray.census.objects[type] += census->objects[type];
+      gcol_gray.census.bytes[type] += census->bytes[type];
     }
+    memset(census, 0, sizeof *census);
   }
-  // Any type made with `cons()` belongs here.
-  if (pairp(*root) || closurep(*root) || macrop(*root)) {
-    ConsAllocation *alloc = (ConsAllocation *)
-      ((char *)root->value.pair - offsetof(ConsAllocation, pair));
-    if (alloc->mark == 0) { return; }
-    if (alloc->mark == mark_num) {
-      alloc->mark = 0;
-      gcol_unmark(&car(*root), mark_num);
-      gcol_unmark(&cdr(*root), mark_num);
+}
+
+#else
+
+void gcol_mark_gray_parallel(size_t threads) {
+  (void)threads;
+  gcol_mark_gray(-1);
+}
+
+#endif /* #ifdef LITE_GCOL_THREADS */
+
+void gcol_write_barrier(Atom object, Atom value) {
+  if (gcol_marking) {
+    // Whatever has already been marked through won't be again, so
+    // anything written into it must be marked now.
+    if (cons_made(object)) {
+      if (*cons_mark(object.value.pair)) { gcol_shade(&value); }
+    } else if (envp(object)) {
+      if (galloc_of(object.value.env)->mark) { gcol_shade(&value); }
     }
   }
-  if (envp(*root)) {
-    size_t index = 0;
-    EnvironmentValue *entry;
-    while (index < root->value.env->data_capacity) {
-      entry = root->value.env->data + index;
-      if (entry->key) {
-        gcol_unmark(&entry->value, mark_num);
+  if (!gcol_young(value)) {
+    return;
+  }
+  if (cons_made(object)) {
+    if (*cons_mark(object.value.pair) == 0) { return; }
+  } else if (envp(object)) {
+    if (galloc_of(object.value.env)->mark == 0) { return; }
+  } else {
+    return;
+  }
+  if (gcol_remembered_count
+      && gcol_remembered[gcol_remembered_count - 1].value.pair == object.value.pair) {
+    return;
+  }
+  if (gcol_remembered_count >= gcol_remembered_capacity) {
+    size_t new_capacity = gcol_remembered_capacity ? gcol_remembered_capacity * 2 : 256;
+    Atom *new_remembered = realloc(gcol_remembered, new_capacity * sizeof(Atom));
+    if (!new_remembered) {
+      fprintf(stderr, "GCOL: Could not allocate memory for remembered set.\n");
+      exit(1);
+    }
+    gcol_remembered = new_remembered;
+    gcol_remembered_capacity = new_capacity;
+  }
+  gcol_remembered[gcol_remembered_count++] = object;
+}
+
+void gcol_region_begin(void) {
+  cons_region = 1;
+}
+
+int gcol_region_active(void) {
+  return cons_region;
+}
+
+void gcol_start_region(void) {
+  cons_region = 0;
+  gcol_region_collection = 1;
+  gcol_start(0);
+}
+
+void gcol_start(char major) {
+  // Anything but a collection of just the region in progress ends it,
+  // and collects what has been allocated into it like anything else.
+  if (!gcol_region_collection) {
+    cons_region_splice();
+    cons_region = 0;
+  }
+  gcol_major = major;
+  gcol_marking = 0;
+  gcol_gray.count = 0;
+  if (major) {
+    memset(&gcol_gray.census, 0, sizeof gcol_gray.census);
+    // Forget what has survived; everything must be marked anew.
+    for (ConsPage *page = cons_pages; page; page = page->next) {
+      memset(page->marks, 0, page->bump);
+    }
+    for (size_t class = 0; class < GALLOC_CLASS_COUNT; ++class) {
+      for (GallocPage *page = galloc_classes[class].pages; page; page = page->next) {
+        for (size_t i = 0; i < page->bump; ++i) {
+          galloc_block(page, i)->mark = 0;
+        }
       }
-      ++index;
     }
-    if (envp(root->value.env->parent)) {
-      gcol_unmark(&root->value.env->parent, mark_num);
+    for (GenericAllocation *galloc = galloc_large; galloc; galloc = galloc->next) {
+      galloc->mark = 0;
     }
+    return;
+  }
+  // Remembered objects are already marked, so are left to be marked
+  // through along with the roots.
+  for (size_t i = 0; i < gcol_remembered_count; ++i) {
+    gcol_stack_push(&gcol_gray, gcol_remembered[i]);
   }
 }
 
+/// Sweep PAGE, rebuilding it's free list from scratch. Return how many
+/// pairs are still in use.
+static size_t cons_page_sweep(ConsPage *page) {
+  ConsCell *free_cells = NULL;
+  size_t used = 0;
+  for (size_t i = page->bump; i-- > 0;) {
+    if (page->marks[i]) {
+      used += 1;
+    } else {
+      page->cells[i].next_free = free_cells;
+      free_cells = page->cells + i;
+    }
+  }
+  pair_allocations_freed += page->used - used;
+  page->free = free_cells;
+  page->used = used;
+  return used;
+}
 
 void gcol_cons(void) {
-  // Sweep cons allocations (pairs).
-  ConsAllocation **pair_allocations_it = &global_pair_allocations;
-  ConsAllocation *prev_pair_allocation = NULL;
-  ConsAllocation *pair_allocation;
-  while ((pair_allocation = *pair_allocations_it)) {
-    if (pair_allocation->mark == 0) {
-      *pair_allocations_it = pair_allocation->next;
-      if (prev_pair_allocation) {
-        prev_pair_allocation->next = pair_allocation->next;
+  // Sweep pairs, page by page.
+  // Pages after the one being allocated from haven't been allocated
+  // from since the previous collection, so a minor one stops there.
+  ConsPage *end = NULL;
+  if (!gcol_major && cons_page_current) {
+    end = cons_page_current->next;
+  }
+  ConsPage **page_it = &cons_pages;
+  ConsPage *page;
+  ConsPage *last = NULL;
+  while ((page = *page_it) != end) {
+    if (!cons_page_sweep(page)) {
+      // Nothing in use; give the page back.
+      *page_it = page->next;
+      cons_page_free(page);
+      continue;
+    }
+    last = page;
+    page_it = &page->next;
+  }
+  if (!end) {
+    cons_pages_last = last;
+  }
+  cons_page_current = cons_pages;
+}
+
+static void gcol_galloc_class(GallocClass *galloc_class) {
+  // Just like pairs, pages after the one being allocated from needn't
+  // be swept by a minor collection.
+  GallocPage *end = NULL;
+  if (!gcol_major && galloc_class->current) {
+    end = galloc_class->current->next;
+  }
+  GallocPage **page_it = &galloc_class->pages;
+  GallocPage *page;
+  GallocPage *last = NULL;
+  while ((page = *page_it) != end) {
+    GenericAllocation *free_blocks = NULL;
+    char used = 0;
+    for (size_t i = page->bump; i-- > 0;) {
+      GenericAllocation *galloc = galloc_block(page, i);
+      if (galloc->payload && galloc->mark == 0) {
+        galloc_finalize(galloc);
+      }
+      if (galloc->payload) {
+        used = 1;
       } else {
-        global_pair_allocations = pair_allocation->next;
+        galloc->next = free_blocks;
+        free_blocks = galloc;
       }
-      free(pair_allocation);
-      pair_allocation = NULL;
-      pair_allocations_freed += 1;
+    }
+    if (!used) {
+      *page_it = page->next;
+      free(page);
       continue;
     }
-    pair_allocations_it = &pair_allocation->next;
-    prev_pair_allocation = pair_allocation;
-  }
-  // Clear mark.
-  pair_allocation = global_pair_allocations;
-  while (pair_allocation) {
-    if (pair_allocation->mark == 1) {
-      pair_allocation->mark = 0;
+    page->free = free_blocks;
+    last = page;
+    page_it = &page->next;
+  }
+  if (!end) {
+    galloc_class->last = last;
+  }
+  galloc_class->current = galloc_class->pages;
+}
+
+/// Sweep the pages of the region that has just ended. Those with
+/// nothing left in use are given back at once, and the rest join the
+/// heap, at the start of it.
+static void gcol_cons_region(void) {
+  ConsPage *page = cons_region_pages;
+  while (page) {
+    ConsPage *next = page->next;
+    if (!cons_page_sweep(page)) {
+      cons_page_free(page);
+    } else {
+      page->next = cons_pages;
+      if (!cons_pages_last) {
+        cons_pages_last = page;
+      }
+      if (!cons_page_current) {
+        cons_page_current = page;
+      }
+      cons_pages = page;
     }
-    pair_allocation = pair_allocation->next;
+    page = next;
   }
+  cons_region_pages = NULL;
+  cons_region_last = NULL;
 }
 
 void gcol_generic(void) {
-  GenericAllocation **galloc_it = &generic_allocations;
-  GenericAllocation *prev_galloc = NULL;
-  GenericAllocation *galloc = generic_allocations;
-  while ((galloc = *galloc_it) != NULL) {
+  for (size_t class = 0; class < GALLOC_CLASS_COUNT; ++class) {
+    gcol_galloc_class(galloc_classes + class);
+  }
+  // Large allocations are listed newest first, so a minor collection
+  // stops at the first one that is old.
+  GenericAllocation *end = gcol_major ? NULL : galloc_large_old;
+  GenericAllocation **galloc_it = &galloc_large;
+  GenericAllocation *galloc;
+  while ((galloc = *galloc_it) != end) {
     if (galloc->mark == 0) {
       *galloc_it = galloc->next;
-      if (prev_galloc) {
-        prev_galloc->next = galloc->next;
-      } else {
-        generic_allocations = galloc->next;
-      }
-      if (galloc->payload) {
-        free(galloc->payload);
-        galloc->payload = NULL;
-      }
+      galloc_finalize(galloc);
       free(galloc);
-      galloc = NULL;
-      generic_allocations_freed += 1;
       continue;
     }
     galloc_it = &galloc->next;
-    prev_galloc = galloc;
-  }
-  // Clear mark.
-  galloc = generic_allocations;
-  while (galloc) {
-    if (galloc->mark == 1) {
-      galloc->mark = 0;
-    }
-    galloc = galloc->next;
   }
+  galloc_large_old = galloc_large;
 }
 
 void gcol(void) {
-  gcol_cons();
+  // Marks are left as they are: whatever survived is now old.
+  assert(!gcol_gray.count && "gcol(): Marking must be finished with gcol_mark_gray() first.");
+  gcol_marking = 0;
+  if (gcol_region_collection) {
+    gcol_cons_region();
+  } else {
+    gcol_cons();
+  }
   gcol_generic();
+  gcol_remembered_count = 0;
+  gcol_region_collection = 0;
+  if (gcol_major) {
+    gcol_census_last = gcol_gray.census;
+  }
 }
 
 void print_gcol_data(void) {
@@ -277,7 +1067,7 @@ void print_gcol_data(void) {
          , pair_allocations_count
          , pair_allocations_freed
          , pair_allocations_in_use
-         , pair_allocations_in_use * sizeof(ConsAllocation)
+         , pair_allocations_in_use * sizeof(Pair)
          , generic_allocations_count
          , generic_allocations_freed
          , generic_allocations_in_use
@@ -288,20 +1078,16 @@ void print_gcol_data(void) {
 //================================================================ END garbage_collection
 
 Atom cons(Atom car_atom, Atom cdr_atom) {
-  ConsAllocation *alloc;
-  alloc = malloc(sizeof(ConsAllocation));
-  if (!alloc) {
+  Pair *pair = cons_pair_allocate();
+  if (!pair) {
     printf("CONS: Could not allocate memory for new allocation!");
     return nil;
   }
-  alloc->mark = 0;
-  alloc->next = global_pair_allocations;
-  global_pair_allocations = alloc;
   pair_allocations_count += 1;
 
   Atom newpair = nil;
   newpair.type = ATOM_TYPE_PAIR;
-  newpair.value.pair = &alloc->pair;
+  newpair.value.pair = pair;
   car(newpair) = car_atom;
   cdr(newpair) = cdr_atom;
 
@@ -313,25 +1099,12 @@ Atom cons(Atom car_atom, Atom cdr_atom) {
   return newpair;
 }
 
-Atom nil_with_docstring(char *docstring) {
-  Atom doc = nil;
-  doc.docstring = docstring;
-  return doc;
-}
-
 Atom make_int(integer_t value) {
   Atom a = nil;
   a.type = ATOM_TYPE_INTEGER;
   a.value.integer = value;
   return a;
 }
-Atom make_int_with_docstring(integer_t value, char *docstring) {
-  Atom a = nil;
-  a.type = ATOM_TYPE_INTEGER;
-  a.value.integer = value;
-  a.docstring = docstring;
-  return a;
-}
 
 //================================================================ BEG SYMBOL_TABLE
 
@@ -445,6 +1218,19 @@ static char *symbol_table_get_or_insert(SymbolTable *table, char *key) {
   return *entry;
 }
 
+/// Create a copy of KEY to intern, preceded by it's (zeroed) flags.
+static char *symbol_name_create(char *key) {
+  size_t length = strlen(key);
+  char *name = malloc(length + 2);
+  if (!name) {
+    fprintf(stderr, "Could not allocate memory for new symbol.\n");
+    exit(1);
+  }
+  name[0] = 0;
+  memcpy(name + 1, key, length + 1);
+  return name + 1;
+}
+
 /// Attempt to get symbol at KEY, inserting a duplicate of KEY if not found.
 static char *symbol_table_get_or_insert_duplicate(SymbolTable *table, char *key) {
   // If data_count is too close to data_capacity, expand.
@@ -457,7 +1243,7 @@ static char *symbol_table_get_or_insert_duplicate(SymbolTable *table, char *key)
   // If entry contains NULL string, insert duplicate.
   if (!(*entry)) {
     //printf("Inserting \"%s\"\n", key);
-    *entry = strdup(key);
+    *entry = symbol_name_create(key);
     table->data_count += 1;
   }
   return *entry;
@@ -523,10 +1309,21 @@ Atom symbol_table(void) {
 #ifndef LITE_SYMBOL_TABLE_INITIAL_CAPACITY
 # define LITE_SYMBOL_TABLE_INITIAL_CAPACITY 1024
 #endif /* LITE_SYMBOL_TABLE_INITIAL_CAPACITY */
-Atom make_sym(char *value) {
-  if (table.data_capacity == 0) {
-    table = symbol_table_create(LITE_SYMBOL_TABLE_INITIAL_CAPACITY);
+Atom well_known_symbols[WELL_KNOWN_SYMBOL_COUNT];
+
+void symbols_initialize(void) {
+  if (table.data_capacity) {
+    return;
   }
+  table = symbol_table_create(LITE_SYMBOL_TABLE_INITIAL_CAPACITY);
+#define WELL_KNOWN_SYMBOL_INTERN(name, string)                          \
+  well_known_symbols[WELL_KNOWN_SYMBOL_##name] = make_sym(string);
+  WELL_KNOWN_SYMBOLS(WELL_KNOWN_SYMBOL_INTERN)
+#undef WELL_KNOWN_SYMBOL_INTERN
+}
+
+Atom make_sym(char *value) {
+  symbols_initialize();
 
   // Try to get existing entry in symbol table.
   char *symbol = NULL;
@@ -539,26 +1336,125 @@ Atom make_sym(char *value) {
   return a;
 }
 
+unsigned char *symbol_flags(Atom symbol) {
+  return (unsigned char *)symbol.value.symbol - 1;
+}
+
+typedef struct DocstringEntry {
+  char *symbol; //> NULL while the entry isn't in use.
+  char *docstring;
+} DocstringEntry;
+
+/// Docstrings of symbols, keyed by the (interned) symbol itself.
+static struct {
+  size_t count;
+  size_t capacity;
+  DocstringEntry *data;
+} docstrings = { 0, 0, NULL };
+
+/// Return the entry for SYMBOL in the docstring table, which is either
+/// in use by SYMBOL or not in use at all. The table must not be full.
+static DocstringEntry *docstring_entry(char *symbol) {
+  uint64_t key = (uint64_t)(uintptr_t)symbol;
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  size_t mask = docstrings.capacity - 1;
+  size_t index = (size_t)key & mask;
+  while (docstrings.data[index].symbol && docstrings.data[index].symbol != symbol) {
+    index = (index + 1) & mask;
+  }
+  return docstrings.data + index;
+}
+
+static void docstrings_expand(void) {
+  size_t old_capacity = docstrings.capacity;
+  DocstringEntry *old_data = docstrings.data;
+  size_t new_capacity = old_capacity ? old_capacity << 1 : 256;
+  DocstringEntry *new_data = calloc(new_capacity, sizeof *new_data);
+  if (!new_data) {
+    fprintf(stderr, "Could not allocate memory for docstring table.\n");
+    exit(1);
+  }
+  docstrings.capacity = new_capacity;
+  docstrings.data = new_data;
+  for (size_t i = 0; i < old_capacity; ++i) {
+    if (old_data[i].symbol) {
+      *docstring_entry(old_data[i].symbol) = old_data[i];
+    }
+  }
+  free(old_data);
+}
+
+void symbol_set_docstring(Atom symbol, const char *docstring) {
+  if (docstrings.count >= docstrings.capacity >> 1) {
+    docstrings_expand();
+  }
+  DocstringEntry *entry = docstring_entry(symbol.value.symbol);
+  if (entry->symbol) {
+    if (strcmp(entry->docstring, docstring) == 0) {
+      return;
+    }
+    free(entry->docstring);
+  } else {
+    entry->symbol = symbol.value.symbol;
+    docstrings.count += 1;
+  }
+  entry->docstring = strdup(docstring);
+  if (!entry->docstring) {
+    fprintf(stderr, "Could not allocate memory for docstring.\n");
+    exit(1);
+  }
+}
+
+const char *symbol_docstring(Atom symbol) {
+  if (!docstrings.count) {
+    return NULL;
+  }
+  return docstring_entry(symbol.value.symbol)->docstring;
+}
+
 Atom make_string(char *contents) {
   if (!contents) { return nil; }
   Atom string = nil;
   string.type = ATOM_TYPE_STRING;
-  string.value.symbol = strdup(contents);
+  size_t size = strlen(contents) + 1;
+  string.value.symbol = gcol_allocate(size, NULL);
   if (!string.value.symbol) {
     printf("Could not allocate memory for new string.\n");
     return nil;
   }
-  // Register allocated string in garbage collector.
-  gcol_generic_allocation(&string, (void *)string.value.symbol);
+  memcpy(string.value.symbol, contents, size);
   return string;
 }
 
+/// Every BuiltIn made by make_builtin(), a block at a time.
+#define BUILTIN_BLOCK_SIZE 64
+typedef struct BuiltInBlock {
+  struct BuiltInBlock *next;
+  size_t count;
+  BuiltIn builtins[BUILTIN_BLOCK_SIZE];
+} BuiltInBlock;
+static BuiltInBlock *builtin_blocks = NULL;
+
 Atom make_builtin(BuiltInFunction function, char *name, char *docstring) {
+  if (!builtin_blocks || builtin_blocks->count >= BUILTIN_BLOCK_SIZE) {
+    BuiltInBlock *block = malloc(sizeof *block);
+    if (!block) {
+      printf("Could not allocate memory for new builtin.\n");
+      return nil;
+    }
+    block->next = builtin_blocks;
+    block->count = 0;
+    builtin_blocks = block;
+  }
+  BuiltIn *new_builtin = builtin_blocks->builtins + builtin_blocks->count++;
+  new_builtin->name = name;
+  new_builtin->function = function;
+  new_builtin->docstring = docstring;
   Atom builtin = nil;
   builtin.type = ATOM_TYPE_BUILTIN;
-  builtin.value.builtin.function = function;
-  builtin.value.builtin.name = name;
-  builtin.docstring = docstring;
+  builtin.value.builtin = new_builtin;
   return builtin;
 }
 
@@ -595,6 +1491,10 @@ Error make_closure(Atom environment, Atom arguments, Atom body, Atom *result) {
   return ok;
 }
 
+static void buffer_finalize(void *buffer) {
+  buffer_release(buffer);
+}
+
 Atom make_buffer(Atom environment, char *path) {
   if (!path) {
     MAKE_ERROR(args, ERROR_ARGUMENTS, nil
@@ -624,11 +1524,20 @@ Atom make_buffer(Atom environment, char *path) {
     buffer_table_it = cdr(buffer_table_it);
   }
   // Create new buffer and add it to buffer table.
-  // NOTE: buffer_path now owned by buffer.
-  Buffer *buffer = buffer_create(buffer_path);
+  // The path, rope and history of the buffer are freed along with it.
+  Buffer *buffer = gcol_allocate(sizeof(Buffer), buffer_finalize);
   if (!buffer) {
+    free(buffer_path);
     MAKE_ERROR(err, ERROR_MEMORY, nil
-               , "make_buffer: `buffer_create(path)` failed!."
+               , "make_buffer: Could not allocate memory for new buffer."
+               , NULL);
+    print_error(err);
+    return nil;
+  }
+  // NOTE: buffer_path now owned by buffer.
+  if (!buffer_init(buffer, buffer_path)) {
+    MAKE_ERROR(err, ERROR_MEMORY, nil
+               , "make_buffer: `buffer_init(buffer, path)` failed!."
                , NULL);
     print_error(err);
     return nil;
@@ -636,13 +1545,6 @@ Atom make_buffer(Atom environment, char *path) {
   buffer->environment = environment;
 
   Atom result = nil;
-  gcol_generic_allocation(&result, buffer);
-  gcol_generic_allocation(&result, buffer->path);
-
-  // FIXME: Rope contents probably don't get freed since we aren't calling
-  // rope_free().
-  gcol_generic_allocation(&result, buffer->rope);
-
   result.type = ATOM_TYPE_BUFFER;
   result.value.buffer = buffer;
 
@@ -690,6 +1592,7 @@ void list_set(Atom list, int k, Atom value) {
     list = cdr(list);
   }
   car(list) = value;
+  gcol_write_barrier(list, value);
 }
 
 void list_push(Atom *list, Atom value) {
@@ -707,6 +1610,7 @@ void list_reverse(Atom *list) {
   while (!nilp(*list)) {
     Atom p = cdr(*list);
     cdr(*list) = tail;
+    gcol_write_barrier(*list, tail);
     tail = *list;
     *list = p;
   }
@@ -822,7 +1726,7 @@ void print_atom(Atom atom) {
     printf("%lli", atom.value.integer);
     break;
   case ATOM_TYPE_BUILTIN:
-    printf("#<BUILTIN>:%s", atom.value.builtin.name);
+    printf("#<BUILTIN>:%s", atom.value.builtin->name);
     break;
   case ATOM_TYPE_CLOSURE:
     printf("#<CLOSURE>:%p", (void *)&atom);
@@ -1000,10 +1904,10 @@ char *atom_string(Atom atom, char *buffer) {
     }
     break;
   case ATOM_TYPE_BUILTIN:
-    to_add = format_bufsz(builtin_format, atom.value.builtin.name);
+    to_add = format_bufsz(builtin_format, atom.value.builtin->name);
     buffer = realloc(buffer, length+to_add);
     if (!buffer) { return NULL; }
-    snprintf(buffer+length, to_add, builtin_format, atom.value.builtin.name);
+    snprintf(buffer+length, to_add, builtin_format, atom.value.builtin->name);
     break;
   case ATOM_TYPE_CLOSURE:
     to_add = format_bufsz(closure_format, &atom);
@@ -1058,7 +1962,7 @@ Atom compare_atoms(Atom a, Atom b) {
       equal = (a.value.integer == b.value.integer);
       break;
     case ATOM_TYPE_BUILTIN:
-      equal = (a.value.builtin.function == b.value.builtin.function);
+      equal = (a.value.builtin->function == b.value.builtin->function);
       break;
     case ATOM_TYPE_BUFFER:
       equal = (a.value.buffer == b.value.buffer);
@@ -1071,5 +1975,5 @@ Atom compare_atoms(Atom a, Atom b) {
       break;
     }
   }
-  return equal ? make_sym("T") : nil;
+  return equal ? SYM(T) : nil;
 }
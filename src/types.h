@@ -16,9 +16,12 @@ struct Atom;
 /// All C functions that are to be called from LISP will have this prototype.
 typedef struct Error (*BuiltInFunction)(struct Atom arguments, struct Atom *result);
 
+/// Builtin atoms refer to one of these, so that an atom needs no more
+/// room for a builtin than it does for a pointer.
 typedef struct BuiltIn {
   char *name;
   BuiltInFunction function;
+  char *docstring;
 } BuiltIn;
 
 struct Environment;
@@ -46,12 +49,10 @@ typedef struct Atom {
     struct Pair *pair;
     char *symbol;
     Buffer *buffer;
-    BuiltIn builtin;
+    const BuiltIn *builtin;
     integer_t integer;
     struct Environment *env;
   } value;
-  char *docstring;
-  GenericAllocation *galloc;
 } Atom;
 
 typedef struct Pair {
@@ -60,18 +61,24 @@ typedef struct Pair {
 
 typedef struct EnvironmentValue {
   char *key;  //> Symbol pointer
+  /// How far the entry is from where it's key hashes to.
+  size_t distance;
   Atom value;
 } EnvironmentValue;
 
 typedef struct Environment {
   struct Atom parent;
+  /// The parameters of the closure or macro this was made to call, or
+  /// nil if it wasn't made for a call.
+  struct Atom parameters;
+  /// Non-zero iff this is the global environment, or descends from it.
+  char global_descendant;
   size_t data_count;
   size_t data_capacity;
   struct EnvironmentValue *data;
-  GenericAllocation *galloc_data;
 } Environment;
 
-static const Atom nil = { ATOM_TYPE_NIL,     { 0 }, NULL, NULL };
+static const Atom nil = { ATOM_TYPE_NIL,     { 0 } };
 
 #define nilp(a)     ((a).type == ATOM_TYPE_NIL)
 #define pairp(a)    ((a).type == ATOM_TYPE_PAIR)
@@ -95,54 +102,66 @@ static const Atom nil = { ATOM_TYPE_NIL,     { 0 }, NULL, NULL };
  * be freed in the subsequent sweep. The sweep is simply freeing all
  * unmarked memory.
  * There are two types of memory that may be garbage collected:
- * - ConsAllocation :: A pair Atom. Contains space for two child Atoms.
- * - GenericAllocation :: Data attached to any Atom that must be freed
- *   along with it. This includes strings for String Atoms, and is
- *   generic enough to allow any amount of data to be allocated and
- *   de-allocated along with any Atom.
+ * - Pairs :: Made by `cons()`. Pairs are allocated from large, aligned
+ *   pages, each with their marks kept alongside in an array of their
+ *   own, a byte per pair. Sweeping goes over the pages, and a page
+ *   that has nothing in use left is handed back.
+ * - GenericAllocation :: Data that an Atom points to, that must be
+ *   freed along with it: strings, environments, and buffers. Data is
+ *   allocated directly after the generic allocation that keeps track
+ *   of it (see gcol_allocate()), from pages of blocks of a few
+ *   different sizes, which are swept just like the pages of pairs.
+ *   Atoms themselves hold nothing but a pointer to the data; the
+ *   generic allocation is found right before it. Data that owns more
+ *   than a single block of memory (i.e. a buffer) is given a finalizer
+ *   that frees the rest of it.
+ *
+ * Collection is generational: most collections are minor, and only
+ * free what was allocated since the last one (see gcol_start()).
  */
 
-typedef struct ConsAllocation {
-  struct ConsAllocation *next;
-  Pair pair;
-  size_t mark;
-} ConsAllocation;
-
-extern ConsAllocation *global_pair_allocations;
 extern size_t pair_allocations_count;
 extern size_t pair_allocations_freed;
 
+/// Frees everything the payload of a generic allocation owns once it
+/// is collected.
+typedef void (*GenericFinalizer)(void *payload);
+
 typedef struct GenericAllocation {
+  /// The next free block in the same page, or the next allocation too
+  /// large for any page.
   struct GenericAllocation *next;
-  struct GenericAllocation *more;
-  Atom ref;
-  void *payload;
-  size_t mark;
+  void *payload; //> NULL while the block isn't in use.
+  GenericFinalizer finalize; //> NULL if the payload owns nothing.
+  unsigned char mark;
 } GenericAllocation;
 
-extern GenericAllocation *generic_allocations;
 extern size_t generic_allocations_count;
 extern size_t generic_allocations_freed;
 
-/** Attach allocated pointer to an existing Atom to be freed when the
- *  Atom is.
+/** Allocate SIZE bytes that are freed once no Atom points to them, in
+ *  a single allocation along with the generic allocation itself.
+ *
+ * The payload is not initialized, just like with `malloc()`. Only the
+ * string of a string Atom, the environment of an environment Atom, and
+ * the buffer of a buffer Atom may be allocated this way;
+ * the garbage collector finds the generic allocation of each by
+ * pointer, and that's all it knows to look for.
  *
- * @param ref The referring atom that the payload will be attached to.
- * @param payload A pointer to allocated memory that will be freed when
- *                the Atom is no longer needed.
+ * @param finalize If non-NULL, called on the payload just before it is
+ *                 freed; it must free only what the payload owns.
  *
- * @retval ERROR_NONE Success
- * @retval ERROR_ARGUMENTS One of the arguments was NULL.
- * @retval ERROR_MEMORY Could not allocate memory for new generic
- *                      allocation.
+ * @return A pointer to the payload, or NULL if out of memory.
  */
-Error gcol_generic_allocation(Atom *ref, void *payload);
+void *gcol_allocate(size_t size, GenericFinalizer finalize);
 
 /** Mark atoms that are accessible from a given root as in-use,
  *  preventing them from being garbage collected.
  *
  * This will mark pairs that have been allocated with `cons`, as well
- * as generic allocations registered to atoms.
+ * as the generic allocations that atoms point to. However deeply nested or
+ * long the lists reachable from ROOT are, marking them takes no room
+ * on the C stack.
  *
  * DO NOT CALL WITH NULL ARGUMENT!
  *
@@ -152,38 +171,137 @@ Error gcol_generic_allocation(Atom *ref, void *payload);
  */
 void gcol_mark(Atom *root);
 
-size_t gcol_explicit_frame();
+/** Register the atom at ROOT to be marked by every subsequent call to
+ *  gcol_shade_roots(), until it is unregistered with gcol_root_pop().
+ *
+ * Roots are registered and unregistered in last-in-first-out order;
+ * this is how C code holding on to atoms across evaluation keeps them
+ * from being collected out from under it.
+ *
+ * DO NOT CALL WITH NULL ARGUMENT!
+ */
+void gcol_root_push(Atom *root);
+
+/// Unregister the COUNT most recently registered roots.
+void gcol_root_pop(size_t count);
+
+/// Shade every registered root with gcol_shade(), leaving what they
+/// refer to for gcol_mark_gray() or gcol_mark_gray_parallel().
+void gcol_shade_roots(void);
 
-/** Just like gcol_mark() except it won't be unmarked at next gcol().
+/** Return non-zero iff the pair allocation of ROOT is currently marked.
  *
- * Mark atoms that are accessible from a given root as in-use,
- * preventing them from being garbage collected.
+ * Only meaningful for atoms made with `cons()`; always zero for
+ * anything else.
+ */
+int gcol_marked(Atom root);
+
+/** Start a garbage collection, before anything is marked.
  *
- * This will mark pairs that have been allocated with `cons`, as well
- * as generic allocations registered to atoms.
+ * Anything that survives a collection is old, and stays marked until
+ * the next major collection. A minor collection only frees what has
+ * been allocated since the previous collection; old pairs and
+ * environments aren't marked through again, except for those that
+ * have been written into since (see gcol_write_barrier()). Those are
+ * shaded, and left to be marked through along with everything else.
  *
- * DO NOT CALL WITH NULL ARGUMENT!
+ * A major collection forgets which allocations are old, and frees
+ * everything that isn't marked.
  */
-void gcol_mark_explicit(Atom *root);
+void gcol_start(char major);
 
-/** Unmark all allocations reachable from ROOT unconditionally.
+/** Allocate pairs into a region of pages of their own, until the
+ *  region is ended by gcol_start_region().
  *
- * Used to unmark atoms marked with gcol_mark_explicit(), mainly,
- * due to it's unconditional unmarking.
+ * Most of what a short evaluation allocates is garbage by the time it
+ * is finished. Collecting just the region then only sweeps the pages
+ * of the region; those with nothing left in use are given back whole.
+ * Any other collection started in the meantime ends the region, and
+ * collects what has been allocated into it like anything else.
+ */
+void gcol_region_begin(void);
+
+/// Return non-zero iff pairs are being allocated into a region.
+int gcol_region_active(void);
+
+/** End the region in progress, and start a minor collection that only
+ *  frees pairs allocated into it.
  *
- * DO NOT CALL WITH NULL ARGUMENT!
+ * Whatever escaped the region is found just like with any other minor
+ * collection: through the roots, and the old pairs and environments it
+ * was written into (see gcol_write_barrier()). The collection must be
+ * marked and finished just like one started with gcol_start().
  */
-void gcol_unmark(Atom *root, size_t mark_num);
+void gcol_start_region(void);
 
-/** Do a garbage collection.
+/** Start a major collection that is marked a little at a time.
+ *
+ * Roots that aren't marked again when finishing the collection are
+ * shaded with gcol_shade(), and then marked through with
+ * gcol_mark_gray() in between evaluation, for as long as it takes.
+ * Anything written into what has been marked in the meantime is
+ * shaded by gcol_write_barrier(). To finish, every root must be marked
+ * once more, and then gcol_mark_gray() run to completion, before
+ * calling gcol().
+ *
+ * Nothing allocated while marking is marked until it's found to be in
+ * use, just like anything else.
+ */
+void gcol_start_incremental(void);
+
+/// Mark ROOT as in-use, leaving what it refers to for gcol_mark_gray().
+void gcol_shade(Atom *root);
+
+/** Mark through what has been shaded for about BUDGET microseconds,
+ *  or until there's nothing left if BUDGET is negative.
+ *
+ * @return Non-zero iff there's nothing left to mark through.
+ */
+int gcol_mark_gray(integer_t budget);
+
+/** Mark through everything that has been shaded until there's nothing
+ *  left, spread across THREADS threads (including the calling one).
+ *
+ * Only the marking itself happens on other threads, and only until
+ * this returns; nothing else may be happening at the same time.
+ * Marking is done on just the calling thread if LITE was built without
+ * LITE_GCOL_THREADS, or if no more threads could be started.
+ */
+void gcol_mark_gray_parallel(size_t threads);
+
+/** Record that VALUE has been written into OBJECT, a pair or an
+ *  environment.
+ *
+ * Must be called whenever an existing pair or environment has any of
+ * it's contents replaced, or a minor collection may free VALUE while
+ * OBJECT still refers to it, as may an incremental one that already
+ * marked through OBJECT. Newly made ones needn't bother.
+ */
+void gcol_write_barrier(Atom object, Atom value);
+
+/** Do a garbage collection, started with gcol_start().
  *
  * For all allocations within the global allocation list, free
  * allocations not marked as in use.
  *
- * Both ConsAllocation and GenericAllocation are handled.
+ * Both pairs and GenericAllocation are handled.
  */
 void gcol(void);
 
+/// How many of each type of atom were found in use, and how many bytes
+/// they take up (not counting what they refer to).
+typedef struct GcolCensus {
+  size_t objects[ATOM_TYPE_MAX];
+  size_t bytes[ATOM_TYPE_MAX];
+} GcolCensus;
+
+/** Return what was found in use by the most recent major collection.
+ *
+ * Minor collections don't mark what is old, so only a major collection
+ * counts everything that is in use.
+ */
+const GcolCensus *gcol_census(void);
+
 /** Print all data collected surrounding garbage collection.
  *
  * This includes amount of created and freed allocations for both types
@@ -280,11 +398,76 @@ Atom alist_get(Atom alist, Atom key);
 /// Set the value associated with a key in a given alist.
 void alist_set(Atom *alist, Atom key, Atom value);
 
-Atom nil_with_docstring(char *docstring);
 Atom make_int(integer_t value);
-Atom make_int_with_docstring(integer_t value, char *docstring);
 Atom make_sym(char *value);
+
+/** Symbols that C refers to often enough that they shouldn't be
+ *  looked up in the symbol table every time.
+ *
+ * Each is interned along with the symbol table itself, after which
+ * SYM(NAME) is the very same atom make_sym() would return for it.
+ * To add one, add a line here.
+ */
+#define WELL_KNOWN_SYMBOLS(X)                   \
+  X(T,                "T")                      \
+  X(QUOTE,            "QUOTE")                  \
+  X(QUASIQUOTE,       "QUASIQUOTE")             \
+  X(UNQUOTE,          "UNQUOTE")                \
+  X(UNQUOTE_SPLICING, "UNQUOTE-SPLICING")       \
+  X(APPEND,           "APPEND")                 \
+  X(CONS,             "CONS")                   \
+  X(COPY,             "COPY")                   \
+  X(WHILE_BODY,       "WHILE-BODY")             \
+  X(NOT_BOUND,        "NOT-BOUND")              \
+  X(CURRENT_BUFFER,   "CURRENT-BUFFER")         \
+  X(POPUP_BUFFER,     "POPUP-BUFFER")           \
+  X(KEYMAP,           "KEYMAP")                 \
+  X(CURRENT_KEYMAP,   "CURRENT-KEYMAP")         \
+  X(FINISH_READ,      "FINISH-READ")            \
+  X(WINDOWS,          "WINDOWS")                \
+  X(ACTIVE_WINDOW_INDEX, "ACTIVE-WINDOW-INDEX") \
+  X(DEBUG_KEYBINDING, "DEBUG/KEYBINDING")       \
+  X(DEBUG_MEMORY,     "DEBUG/MEMORY")
+
+typedef enum WellKnownSymbol {
+#define WELL_KNOWN_SYMBOL_ENUMERATOR(name, string) WELL_KNOWN_SYMBOL_##name,
+  WELL_KNOWN_SYMBOLS(WELL_KNOWN_SYMBOL_ENUMERATOR)
+#undef WELL_KNOWN_SYMBOL_ENUMERATOR
+  WELL_KNOWN_SYMBOL_COUNT
+} WellKnownSymbol;
+
+extern Atom well_known_symbols[WELL_KNOWN_SYMBOL_COUNT];
+
+/// Create the symbol table and intern every well-known symbol into it,
+/// if that hasn't been done already. make_sym() does so when first
+/// called, so this need only be called before using SYM() when no
+/// symbol could have been made yet.
+void symbols_initialize(void);
+
+/// The interned symbol atom of a WELL_KNOWN_SYMBOLS() entry.
+#define SYM(name) (well_known_symbols[WELL_KNOWN_SYMBOL_##name])
+
+/// Set on a symbol once it has been bound within any environment that
+/// has a parent (i.e. as a parameter, or by a local definition).
+#define SYMBOL_FLAG_LOCALLY_BOUND (1 << 0)
+/// Set on a symbol with a WatchedVariable registered for it.
+#define SYMBOL_FLAG_WATCHED       (1 << 1)
+
+/// Get a pointer to the flags kept with the given (interned) symbol.
+unsigned char *symbol_flags(Atom symbol);
+
+/** Set the docstring of SYMBOL to a copy of DOCSTRING.
+ *
+ * Docstrings are kept in a table of their own, keyed by symbol, for as
+ * long as the program runs; setting the same docstring again (i.e.
+ * re-evaluating a definition) allocates nothing.
+ */
+void symbol_set_docstring(Atom symbol, const char *docstring);
+/// Return the docstring of SYMBOL, or NULL if it has none.
+const char *symbol_docstring(Atom symbol);
 Atom make_string(char *value);
+/// The BuiltIn that the returned Atom refers to lives as long as the
+/// program does, so builtins are best made once, at startup.
 Atom make_builtin(BuiltInFunction function, char *name, char *docstring);
 Error make_closure(Atom environment, Atom arguments, Atom body, Atom *result);
 Atom make_buffer(Atom environment, char *path);
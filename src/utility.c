@@ -2,6 +2,8 @@
 
 #include <assert.h>
 #include <environment.h>
+#include <evaluation.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <types.h>
@@ -14,8 +16,13 @@ void exit_safe(int code) {
 # ifdef LITE_GFX
   destroy_gui();
 # endif
-  int debug_memory = env_non_nil(*genv(), make_sym("DEBUG/MEMORY"));
+  int debug_memory = env_non_nil(*genv(), SYM(DEBUG_MEMORY));
+  if (debug_memory) {
+    print_atom(evaluation_gcol_statistics());
+    putchar('\n');
+  }
   // Garbage collection with no marking means free everything.
+  gcol_start(1);
   gcol();
   if (debug_memory) {
     print_gcol_data();
@@ -15,7 +15,8 @@ extern char **args_vector;
  *
  * If the following debug flags are non-nil in the global LISP
  * environment, extra information will be printed to standard output.
- * - `DEBUG/MEMORY`
+ * - `DEBUG/MEMORY` :: Garbage collection statistics (see
+ *   GARBAGE-COLLECTOR-STATISTICS).
  * .
  *
  * @param[in] code The exit code that is passed to `exit()`.